@@ -0,0 +1,117 @@
+#include "audio_convert.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace audio {
+
+// The loops are kept free of branches and calls, so compilers can vectorize them.
+
+void convert_int16_to_int32(const int16_t *input, int32_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++)
+    output[i] = (int32_t) input[i] * 65536;
+}
+
+void convert_int32_to_int16(const int32_t *input, int16_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++) {
+    int32_t value = (int32_t) (((int64_t) input[i] + 0x8000) >> 16);
+    output[i] = (int16_t) std::min<int32_t>(value, INT16_MAX);
+  }
+}
+
+void convert_int16_to_float(const int16_t *input, float *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++)
+    output[i] = input[i] * (1.0f / 32768.0f);
+}
+
+void convert_float_to_int16(const float *input, int16_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++) {
+    float value = std::max(-32768.0f, std::min(input[i] * 32768.0f, 32767.0f));
+    output[i] = (int16_t) lrintf(value);
+  }
+}
+
+void convert_int32_to_float(const int32_t *input, float *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++)
+    output[i] = input[i] * (1.0f / 2147483648.0f);
+}
+
+void convert_float_to_int32(const float *input, int32_t *output, size_t samples) {
+  for (size_t i = 0; i < samples; i++) {
+    // 2147483520 is the largest float below 2^31
+    float value = std::max(-2147483648.0f, std::min(input[i] * 2147483648.0f, 2147483520.0f));
+    output[i] = (int32_t) value;
+  }
+}
+
+size_t convert_to_int16(const uint8_t *input, uint8_t bits_per_sample, int16_t *output, size_t samples) {
+  switch (bits_per_sample) {
+    case 8:
+      for (size_t i = 0; i < samples; i++)
+        output[i] = (int16_t) ((input[i] - 128) * 256);
+      return samples;
+    case 16:
+      for (size_t i = 0; i < samples; i++)
+        output[i] = (int16_t) (input[2 * i] | (input[2 * i + 1] << 8));
+      return samples;
+    case 24:
+      for (size_t i = 0; i < samples; i++)
+        output[i] = (int16_t) (input[3 * i + 1] | (input[3 * i + 2] << 8));
+      return samples;
+    case 32:
+      for (size_t i = 0; i < samples; i++)
+        output[i] = (int16_t) (input[4 * i + 2] | (input[4 * i + 3] << 8));
+      return samples;
+    default:
+      return 0;
+  }
+}
+
+void convert_mono_to_stereo(const int16_t *input, int16_t *output, size_t frames) {
+  for (size_t i = 0; i < frames; i++) {
+    output[2 * i] = input[i];
+    output[2 * i + 1] = input[i];
+  }
+}
+
+void convert_stereo_to_mono(const int16_t *input, int16_t *output, size_t frames) {
+  for (size_t i = 0; i < frames; i++)
+    output[i] = (int16_t) (((int32_t) input[2 * i] + input[2 * i + 1]) >> 1);
+}
+
+// Lists the Q15 fixed point scaling factor for volume reduction.
+// Has 100 values representing silence and a reduction [49, 48.5, ... 0.5, 0] dB.
+// dB to PCM scaling factor formula: floating_point_scale_factor = 2^(-db/6.014)
+// float to Q15 fixed point formula: q15_scale_factor = floating_point_scale_factor * 2^(15)
+static const int16_t Q15_VOLUME_SCALING_FACTORS[] = {
+    0,     116,   122,   130,   137,   146,   154,   163,   173,   183,   194,   206,   218,   231,   244,
+    259,   274,   291,   308,   326,   345,   366,   388,   411,   435,   461,   488,   517,   548,   580,
+    615,   651,   690,   731,   774,   820,   868,   920,   974,   1032,  1094,  1158,  1227,  1300,  1377,
+    1459,  1545,  1637,  1734,  1837,  1946,  2061,  2184,  2313,  2450,  2596,  2750,  2913,  3085,  3269,
+    3462,  3668,  3885,  4116,  4360,  4619,  4893,  5183,  5490,  5816,  6161,  6527,  6914,  7324,  7758,
+    8218,  8706,  9222,  9770,  10349, 10963, 11613, 12302, 13032, 13805, 14624, 15491, 16410, 17384, 18415,
+    19508, 20665, 21891, 23189, 24565, 26022, 27566, 29201, 30933, 32767};
+
+int16_t volume_to_q15(float volume) {
+  const size_t count = sizeof(Q15_VOLUME_SCALING_FACTORS) / sizeof(Q15_VOLUME_SCALING_FACTORS[0]);
+  float clamped = std::max(0.0f, std::min(volume, 1.0f));
+  return Q15_VOLUME_SCALING_FACTORS[(size_t) (clamped * (count - 1))];
+}
+
+void scale_audio_samples(const int16_t *input, int16_t *output, size_t samples, int16_t factor) {
+  for (size_t i = 0; i < samples; i++) {
+    int32_t acc = (int32_t) input[i] * (int32_t) factor;
+    output[i] = (int16_t) (acc >> 15);
+  }
+}
+
+void scale_audio_samples(const int32_t *input, int32_t *output, size_t samples, int16_t factor) {
+  for (size_t i = 0; i < samples; i++) {
+    int64_t acc = (int64_t) input[i] * factor;
+    output[i] = (int32_t) (acc >> 15);
+  }
+}
+
+}  // namespace audio
+}  // namespace esphome
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace audio {
+
+/// @brief Converts 16 bit samples to 32 bit samples, keeping them at the same level.
+void convert_int16_to_int32(const int16_t *input, int32_t *output, size_t samples);
+
+/// @brief Converts 32 bit samples to 16 bit samples, rounding to nearest.
+void convert_int32_to_int16(const int32_t *input, int16_t *output, size_t samples);
+
+/// @brief Converts 16 bit samples to floats in the range [-1, 1).
+void convert_int16_to_float(const int16_t *input, float *output, size_t samples);
+
+/// @brief Converts floats to 16 bit samples, rounding to nearest and clipping values outside of [-1, 1).
+void convert_float_to_int16(const float *input, int16_t *output, size_t samples);
+
+/// @brief Converts 32 bit samples to floats in the range [-1, 1).
+void convert_int32_to_float(const int32_t *input, float *output, size_t samples);
+
+/// @brief Converts floats to 32 bit samples, clipping values outside of [-1, 1).
+void convert_float_to_int32(const float *input, int32_t *output, size_t samples);
+
+/// @brief Converts packed little endian samples of 8 (unsigned), 16, 24 or 32 bits to 16 bit samples.
+/// @return Number of samples converted, 0 for an unsupported number of bits
+size_t convert_to_int16(const uint8_t *input, uint8_t bits_per_sample, int16_t *output, size_t samples);
+
+/// @brief Duplicates mono samples into interleaved stereo frames. The output may not overlap the input.
+void convert_mono_to_stereo(const int16_t *input, int16_t *output, size_t frames);
+
+/// @brief Averages interleaved stereo frames into mono samples. The output may be the input.
+void convert_stereo_to_mono(const int16_t *input, int16_t *output, size_t frames);
+
+/// @brief Returns the Q15 fixed point factor to scale samples by for a volume, on a logarithmic scale of 49 dB.
+/// @param volume Volume from 0 (silent) to 1 (unchanged)
+int16_t volume_to_q15(float volume);
+
+/// @brief Multiplies samples by a Q15 fixed point factor. The output may be the input.
+///
+/// Based on `dsps_mulc_s16_ansi` from the esp-dsp library:
+/// https://github.com/espressif/esp-dsp/blob/master/modules/math/mulc/fixed/dsps_mulc_s16_ansi.c
+/// (accessed on 2024-09-30).
+/// @param input Array of samples
+/// @param output Array of scaled samples
+/// @param samples Number of samples
+/// @param factor Q15 fixed point factor
+void scale_audio_samples(const int16_t *input, int16_t *output, size_t samples, int16_t factor);
+
+/// @brief Multiplies 32 bit samples by a Q15 fixed point factor. The output may be the input.
+void scale_audio_samples(const int32_t *input, int32_t *output, size_t samples, int16_t factor);
+
+}  // namespace audio
+}  // namespace esphome
@@ -0,0 +1,78 @@
+#include "audio_mixer.h"
+#include "audio_convert.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace esphome {
+namespace audio {
+
+size_t AudioMixer::add_input(bool ducks_others) {
+  this->inputs_.push_back({INT16_MAX, ducks_others});
+  return this->inputs_.size() - 1;
+}
+
+void AudioMixer::set_input_volume(size_t input, float volume) {
+  if (input < this->inputs_.size())
+    this->inputs_[input].volume = volume_to_q15(volume);
+}
+
+void AudioMixer::set_ducking(float volume, uint32_t ramp_frames) {
+  this->duck_volume_ = volume_to_q15(volume);
+  this->duck_step_ = std::max<int32_t>(1, (INT16_MAX - this->duck_volume_) / std::max<uint32_t>(ramp_frames, 1));
+}
+
+/// Moves the gain by the step for each frame towards the target.
+static int32_t ramp_gain(int32_t gain, int32_t target, int32_t step, size_t frames) {
+  int64_t change = (int64_t) step * frames;
+  if (gain > target)
+    return (int32_t) std::max<int64_t>(target, gain - change);
+  return (int32_t) std::min<int64_t>(target, gain + change);
+}
+
+void AudioMixer::mix(const int16_t *const *inputs, const size_t *input_frames, int16_t *output, size_t frames) {
+  const uint8_t channels = this->channels_;
+  this->accumulator_.assign(frames * channels, 0);
+  int32_t *acc = this->accumulator_.data();
+
+  bool ducking = false;
+  for (size_t i = 0; i < this->inputs_.size(); i++) {
+    if (this->inputs_[i].ducks_others && inputs[i] != nullptr && input_frames[i] > 0)
+      ducking = true;
+  }
+  int32_t target = ducking ? this->duck_volume_ : INT16_MAX;
+  int32_t start_gain = this->duck_gain_;
+  size_t ramp_frames =
+      start_gain == target ? 0 : std::min<size_t>(frames, (std::abs(target - start_gain) + this->duck_step_ - 1) /
+                                                              this->duck_step_);
+
+  for (size_t i = 0; i < this->inputs_.size(); i++) {
+    const int16_t *samples = inputs[i];
+    size_t count = std::min(input_frames[i], frames);
+    if (samples == nullptr || count == 0)
+      continue;
+    const Input &input = this->inputs_[i];
+    size_t frame = 0;
+    if (!input.ducks_others) {
+      // while the ducking gain ramps, it changes every frame
+      for (; frame < std::min(count, ramp_frames); frame++) {
+        int32_t gain = ramp_gain(start_gain, target, this->duck_step_, frame + 1);
+        int32_t factor = (input.volume * gain) >> 15;
+        for (uint8_t channel = 0; channel < channels; channel++) {
+          size_t index = frame * channels + channel;
+          acc[index] += (samples[index] * factor) >> 15;
+        }
+      }
+    }
+    int32_t factor = input.ducks_others ? input.volume : (input.volume * target) >> 15;
+    for (size_t index = frame * channels; index < count * channels; index++)
+      acc[index] += (samples[index] * factor) >> 15;
+  }
+  this->duck_gain_ = ramp_gain(start_gain, target, this->duck_step_, frames);
+
+  for (size_t index = 0; index < frames * channels; index++)
+    output[index] = (int16_t) std::max<int32_t>(INT16_MIN, std::min<int32_t>(acc[index], INT16_MAX));
+}
+
+}  // namespace audio
+}  // namespace esphome
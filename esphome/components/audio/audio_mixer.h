@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace audio {
+
+/**
+ * Mixes several streams of interleaved 16 bit samples with the same format into one.
+ *
+ * Inputs are scaled by their Q15 volume and summed with saturation. An input can duck the others: while it provides
+ * audio, like an announcement over music, the other inputs are attenuated to the ducking volume, with a linear ramp so
+ * the change does not click.
+ */
+class AudioMixer {
+ public:
+  /// @brief Adds an input.
+  /// @param ducks_others Whether the other inputs are ducked while this one provides audio
+  /// @return Index of the input
+  size_t add_input(bool ducks_others = false);
+
+  /// @brief Sets the volume of an input, from 0 to 1 on the logarithmic scale of volume_to_q15().
+  void set_input_volume(size_t input, float volume);
+
+  /// @brief Sets the volume that inputs are ducked to and how long the change takes.
+  /// @param volume Volume from 0 to 1 on the logarithmic scale of volume_to_q15()
+  /// @param ramp_frames Frames it takes to duck or restore the volume
+  void set_ducking(float volume, uint32_t ramp_frames);
+
+  void set_channels(uint8_t channels) { this->channels_ = channels; }
+
+  /// @brief Mixes the inputs into the output.
+  ///
+  /// Inputs that provide fewer frames than the output are silent for the rest. An input providing no frames does not
+  /// duck the others.
+  /// @param inputs Samples of each input, nullptr for inputs without audio
+  /// @param input_frames Number of frames of each input
+  /// @param output Mixed samples
+  /// @param frames Number of frames to mix
+  void mix(const int16_t *const *inputs, const size_t *input_frames, int16_t *output, size_t frames);
+
+  /// Whether the inputs that do not duck others are currently attenuated.
+  bool is_ducking() const { return this->duck_gain_ < INT16_MAX; }
+
+ protected:
+  struct Input {
+    int16_t volume;
+    bool ducks_others;
+  };
+
+  std::vector<Input> inputs_;
+  /// Mixed samples before saturation, kept to avoid an allocation per block.
+  std::vector<int32_t> accumulator_;
+  uint8_t channels_{1};
+  int16_t duck_volume_{INT16_MAX};
+  /// Change of the ducking gain per frame.
+  int32_t duck_step_{INT16_MAX};
+  /// Current Q15 gain of the inputs that are ducked.
+  int32_t duck_gain_{INT16_MAX};
+};
+
+}  // namespace audio
+}  // namespace esphome
@@ -0,0 +1,141 @@
+#include "audio_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace audio {
+
+/// Input frames added to the history at once.
+static const size_t CHUNK_FRAMES = 256;
+/// Cutoff of the low pass filter relative to the lower Nyquist frequency, leaving room for the transition band.
+static const float CUTOFF = 0.9f;
+
+static uint32_t gcd(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+bool AudioResampler::configure(uint32_t input_rate, uint32_t output_rate, uint8_t channels, uint8_t taps) {
+  if (input_rate == 0 || output_rate == 0 || channels == 0 || taps < 2)
+    return false;
+  uint32_t divisor = gcd(input_rate, output_rate);
+  this->interpolation_ = output_rate / divisor;
+  this->decimation_ = input_rate / divisor;
+  this->phases_ = this->interpolation_ < MAX_PHASES ? this->interpolation_ : MAX_PHASES;
+  // a downsampler needs a longer filter for the same transition band relative to the output rate
+  uint32_t ratio = (this->decimation_ + this->interpolation_ - 1) / this->interpolation_;
+  this->taps_ = (taps & ~1) * ratio;
+  this->channels_ = channels;
+  if (!this->is_passthrough())
+    this->design_filter_();
+  this->reset();
+  return true;
+}
+
+void AudioResampler::design_filter_() {
+  const float pi = 3.14159265358979f;
+  // relative to the input rate, a downsampler has to remove what is above the output Nyquist frequency
+  float scale = CUTOFF * std::min(1.0f, (float) this->interpolation_ / this->decimation_);
+  float center = this->taps_ / 2 - 1;
+  this->filter_.resize(this->phases_ * this->taps_);
+
+  std::vector<float> coefficients(this->taps_);
+  for (uint16_t phase = 0; phase < this->phases_; phase++) {
+    float sum = 0.0f;
+    for (uint16_t k = 0; k < this->taps_; k++) {
+      // distance of the input sample from the output position, in input frames
+      float x = k - center - (float) phase / this->phases_;
+      float sinc = x == 0.0f ? 1.0f : sinf(pi * scale * x) / (pi * scale * x);
+      // Blackman window over the span of the taps
+      float w = (x + this->taps_ / 2.0f) / this->taps_;
+      float window = 0.42f - 0.5f * cosf(2.0f * pi * w) + 0.08f * cosf(4.0f * pi * w);
+      coefficients[k] = sinc * window;
+      sum += coefficients[k];
+    }
+    // each phase passes DC unchanged, otherwise the phases would modulate a constant signal
+    int16_t *out = &this->filter_[phase * this->taps_];
+    int32_t total = 0;
+    uint16_t largest = 0;
+    for (uint16_t k = 0; k < this->taps_; k++) {
+      out[k] = (int16_t) lrintf(coefficients[k] / sum * 32768.0f);
+      total += out[k];
+      if (out[k] > out[largest])
+        largest = k;
+    }
+    out[largest] += 32768 - total;
+  }
+}
+
+void AudioResampler::reset() {
+  this->position_ = 0;
+  this->phase_ = 0;
+  this->history_.resize(this->channels_);
+  for (auto &history : this->history_) {
+    history.clear();
+    // aligns the first output with the first input frame
+    history.resize(this->taps_ / 2 - 1, 0);
+  }
+}
+
+size_t AudioResampler::process(const int16_t *input, size_t input_frames, int16_t *output, size_t output_frames,
+                               size_t &consumed_frames) {
+  const uint8_t channels = this->channels_;
+  if (this->is_passthrough()) {
+    consumed_frames = std::min(input_frames, output_frames);
+    memmove(output, input, consumed_frames * channels * sizeof(int16_t));
+    return consumed_frames;
+  }
+
+  const uint16_t taps = this->taps_;
+  size_t produced = 0;
+  consumed_frames = 0;
+  while (true) {
+    size_t available = this->history_[0].size();
+    while (produced < output_frames && this->position_ + taps <= available) {
+      size_t phase = (uint64_t) this->phase_ * this->phases_ / this->interpolation_;
+      const int16_t *coefficients = &this->filter_[phase * taps];
+      for (uint8_t channel = 0; channel < channels; channel++) {
+        const int16_t *samples = &this->history_[channel][this->position_];
+        int32_t acc = 0;
+        for (uint16_t k = 0; k < taps; k++)
+          acc += (int32_t) coefficients[k] * samples[k];
+        acc = (acc + (1 << 14)) >> 15;
+        acc = std::max<int32_t>(INT16_MIN, std::min<int32_t>(acc, INT16_MAX));
+        output[produced * channels + channel] = (int16_t) acc;
+      }
+      produced++;
+      this->phase_ += this->decimation_;
+      this->position_ += this->phase_ / this->interpolation_;
+      this->phase_ %= this->interpolation_;
+    }
+
+    // the frames before the position are not needed anymore, when decimating it can be past the end of the history
+    size_t drop = std::min(this->position_, available);
+    for (auto &history : this->history_)
+      history.erase(history.begin(), history.begin() + drop);
+    this->position_ -= drop;
+
+    if (produced == output_frames || consumed_frames == input_frames)
+      break;
+    size_t chunk = std::min(input_frames - consumed_frames, CHUNK_FRAMES);
+    const int16_t *frames = input + consumed_frames * channels;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+      auto &history = this->history_[channel];
+      size_t start = history.size();
+      history.resize(start + chunk);
+      for (size_t i = 0; i < chunk; i++)
+        history[start + i] = frames[i * channels + channel];
+    }
+    consumed_frames += chunk;
+  }
+  return produced;
+}
+
+}  // namespace audio
+}  // namespace esphome
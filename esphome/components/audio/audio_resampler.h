@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace audio {
+
+/**
+ * Streaming sample rate converter for interleaved 16 bit samples.
+ *
+ * A polyphase FIR filter: the windowed sinc low pass filter of the upsampled rate is split into one short filter per
+ * output phase, so each output sample takes a single dot product with the input. The input position advances in
+ * exact rational steps. Ratios with more output phases than the limit use the nearest of the available phases, which
+ * keeps the memory bounded at the cost of a little phase jitter.
+ */
+class AudioResampler {
+ public:
+  /// Filter taps per output phase, the length of the dot product. Downsampling multiplies them by the rounded up ratio.
+  static const uint8_t DEFAULT_TAPS = 32;
+  /// Largest number of filter phases.
+  static const uint16_t MAX_PHASES = 256;
+
+  /// @brief Sets up the conversion and clears the filter state.
+  /// @return false when an argument is zero or the filter could not be allocated
+  bool configure(uint32_t input_rate, uint32_t output_rate, uint8_t channels, uint8_t taps = DEFAULT_TAPS);
+
+  /// @brief Resamples a block of input.
+  ///
+  /// Input frames are consumed while there is room for their output, so the call is repeated with the remaining
+  /// input when the output was filled.
+  /// @param input Interleaved input samples
+  /// @param input_frames Number of input frames
+  /// @param output Interleaved output samples
+  /// @param output_frames Room in the output, in frames
+  /// @param consumed_frames Set to the number of input frames that were consumed
+  /// @return Number of output frames
+  size_t process(const int16_t *input, size_t input_frames, int16_t *output, size_t output_frames,
+                 size_t &consumed_frames);
+
+  /// @brief Clears the filter history, for the start of a new stream.
+  void reset();
+
+  /// Output frames that input_frames produce at most, for sizing the output buffer.
+  size_t get_max_output_frames(size_t input_frames) const {
+    return (size_t) (((uint64_t) input_frames * this->interpolation_ + this->decimation_ - 1) / this->decimation_) + 1;
+  }
+  bool is_passthrough() const { return this->interpolation_ == this->decimation_; }
+
+ protected:
+  void design_filter_();
+
+  /// The rates reduced by their greatest common divisor.
+  uint32_t interpolation_{1};
+  uint32_t decimation_{1};
+  uint16_t phases_{1};
+  uint16_t taps_{DEFAULT_TAPS};
+  uint8_t channels_{1};
+
+  /// Q15 coefficients, taps_ per phase, in the order of the input samples they are applied to.
+  std::vector<int16_t> filter_;
+  /// Input history and pending input per channel, planar so the dot products run over contiguous memory.
+  std::vector<std::vector<int16_t>> history_;
+  /// Frames of the history before the filter window of the next output sample.
+  size_t position_{0};
+  /// Phase of the next output sample, in units of 1 / interpolation_ input frames.
+  uint32_t phase_{0};
+};
+
+}  // namespace audio
+}  // namespace esphome
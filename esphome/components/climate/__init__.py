@@ -46,7 +46,7 @@ from esphome.const import (
     CONF_WEB_SERVER,
 )
 from esphome.core import CORE, coroutine_with_priority
-from esphome.cpp_helpers import setup_entity
+from esphome.cpp_helpers import register_platform_entity, setup_entity
 
 IS_PLATFORM_COMPONENT = True
 
@@ -417,6 +417,7 @@ async def register_climate(var, config):
     if not CORE.has_id(config[CONF_ID]):
         var = cg.Pvariable(config[CONF_ID], var)
     cg.add(cg.App.register_climate(var))
+    register_platform_entity("climate", config)
     await setup_climate_core_(var, config)
 
 
@@ -31,7 +31,7 @@ from esphome.const import (
     DEVICE_CLASS_WINDOW,
 )
 from esphome.core import CORE, coroutine_with_priority
-from esphome.cpp_helpers import setup_entity
+from esphome.cpp_helpers import register_platform_entity, setup_entity
 
 IS_PLATFORM_COMPONENT = True
 
@@ -160,6 +160,7 @@ async def register_cover(var, config):
     if not CORE.has_id(config[CONF_ID]):
         var = cg.Pvariable(config[CONF_ID], var)
     cg.add(cg.App.register_cover(var))
+    register_platform_entity("cover", config)
     await setup_cover_core_(var, config)
 
 
@@ -1,6 +1,6 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.const import CONF_COMPONENTS, CONF_ID, CONF_LAMBDA
+from esphome.const import CONF_COMPONENTS, CONF_ID, CONF_LAMBDA, CONF_SETUP_PRIORITY
 
 custom_component_ns = cg.esphome_ns.namespace("custom_component")
 CustomComponentConstructor = custom_component_ns.class_("CustomComponentConstructor")
@@ -28,4 +28,8 @@ async def to_code(config):
     var = cg.variable(config[CONF_ID], rhs)
     for i, conf in enumerate(config.get(CONF_COMPONENTS, [])):
         comp = cg.Pvariable(conf[CONF_ID], var.get_component(i))
-        await cg.register_component(comp, conf)
+        # CustomComponentConstructor already registers every component the lambda
+        # returns with App, registering them again would set them up twice.
+        if CONF_SETUP_PRIORITY in conf:
+            cg.add(comp.set_setup_priority(conf[CONF_SETUP_PRIORITY]))
+        cg.add(comp.set_component_source("custom_component"))
@@ -23,7 +23,7 @@ from esphome.const import (
 )
 from esphome.core import CORE, coroutine_with_priority
 from esphome.cpp_generator import MockObjClass
-from esphome.cpp_helpers import setup_entity
+from esphome.cpp_helpers import register_platform_entity, setup_entity
 
 CODEOWNERS = ["@rfdarter", "@jesserockz"]
 
@@ -159,6 +159,7 @@ async def register_datetime(var, config):
     if not CORE.has_id(config[CONF_ID]):
         var = cg.Pvariable(config[CONF_ID], var)
     cg.add(getattr(cg.App, f"register_{config[CONF_TYPE].lower()}")(var))
+    register_platform_entity(config[CONF_TYPE].lower(), config)
     await setup_datetime_core_(var, config)
     cg.add_define(f"USE_DATETIME_{config[CONF_TYPE]}")
 
@@ -85,6 +85,11 @@ void Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8
   }
 }
 
+void HOT Display::draw_pixel_row_at(int x, int y, const Color *colors, int count) {
+  for (int i = 0; i != count; i++)
+    this->draw_pixel_at(x + i, y, colors[i]);
+}
+
 void HOT Display::horizontal_line(int x, int y, int width, Color color) {
   // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
   for (int i = x; i < x + width; i++)
@@ -228,6 +228,18 @@ class Display : public PollingComponent {
   /// Set a single pixel at the specified coordinates to the given color.
   virtual void draw_pixel_at(int x, int y, Color color) = 0;
 
+  /** Draw a run of pixels from left to right, starting at the specified coordinates.
+   *
+   * Clipping works as for draw_pixel_at(), which the implementation here calls for every pixel. Displays can override
+   * it to clip and rotate once for the whole run.
+   *
+   * \param x The x position of the first pixel
+   * \param y The y position of the row
+   * \param colors The colors of the pixels
+   * \param count The number of pixels
+   */
+  virtual void draw_pixel_row_at(int x, int y, const Color *colors, int count);
+
   /** Given an array of pixels encoded in the nominated format, draw these into the display's buffer.
    * The naive implementation here will work in all cases, but can be overridden by sub-classes
    * in order to optimise the procedure.
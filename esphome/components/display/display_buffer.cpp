@@ -1,5 +1,6 @@
 #include "display_buffer.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "esphome/core/application.h"
@@ -68,5 +69,55 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::draw_pixel_row_at(int x, int y, const Color *colors, int count) {
+  // clip the run to the display and the clipping rectangle, which includes its right and bottom edges
+  int start = std::max(0, -x);
+  int end = std::min(count, this->get_width() - x);
+  if (y < 0 || y >= this->get_height())
+    return;
+  Rect clipping = this->get_clipping();
+  if (clipping.is_set()) {
+    if (y < clipping.y || y > clipping.y2())
+      return;
+    start = std::max(start, clipping.x - x);
+    end = std::min(end, clipping.x2() + 1 - x);
+  }
+  if (start >= end)
+    return;
+
+  // position of the first pixel in the buffer, and the step to the next one
+  int abs_x = x + start;
+  int abs_y = y;
+  int step_x = 1;
+  int step_y = 0;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      abs_x = this->get_width_internal() - y - 1;
+      abs_y = x + start;
+      step_x = 0;
+      step_y = 1;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      abs_x = this->get_width_internal() - (x + start) - 1;
+      abs_y = this->get_height_internal() - y - 1;
+      step_x = -1;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      abs_x = y;
+      abs_y = this->get_height_internal() - (x + start) - 1;
+      step_x = 0;
+      step_y = -1;
+      break;
+  }
+  for (int i = start; i != end; i++) {
+    this->draw_absolute_pixel_internal(abs_x, abs_y, colors[i]);
+    abs_x += step_x;
+    abs_y += step_y;
+  }
+  App.feed_wdt();
+}
+
 }  // namespace display
 }  // namespace esphome
@@ -21,6 +21,8 @@ class DisplayBuffer : public Display {
 
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
+  /// Draw a run of pixels, clipping and rotating once for the run.
+  void draw_pixel_row_at(int x, int y, const Color *colors, int count) override;
 
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
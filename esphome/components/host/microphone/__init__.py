@@ -0,0 +1,32 @@
+import esphome.codegen as cg
+from esphome.components import microphone
+import esphome.config_validation as cv
+from esphome.const import CONF_FILE, CONF_ID, CONF_REPEAT
+
+AUTO_LOAD = ["audio"]
+
+CONF_REALTIME = "realtime"
+
+host_ns = cg.esphome_ns.namespace("host")
+HostMicrophone = host_ns.class_(
+    "HostMicrophone", microphone.Microphone, cg.Component
+)
+
+CONFIG_SCHEMA = microphone.MICROPHONE_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(HostMicrophone),
+        cv.Required(CONF_FILE): cv.string_strict,
+        cv.Optional(CONF_REALTIME, default=True): cv.boolean,
+        cv.Optional(CONF_REPEAT, default=False): cv.boolean,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await microphone.register_microphone(var, config)
+
+    cg.add(var.set_path(config[CONF_FILE]))
+    cg.add(var.set_realtime(config[CONF_REALTIME]))
+    cg.add(var.set_repeat(config[CONF_REPEAT]))
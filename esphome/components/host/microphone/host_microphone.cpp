@@ -0,0 +1,205 @@
+#ifdef USE_HOST
+
+#include "host_microphone.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace host {
+
+static const char *const TAG = "host.microphone";
+
+/// Samples passed to the data callbacks at once.
+static const size_t BUFFER_SIZE = 512;
+/// Sample rate consumers of a microphone expect.
+static const uint32_t SAMPLE_RATE = 16000;
+
+void HostMicrophone::dump_config() {
+  ESP_LOGCONFIG(TAG, "Host Microphone:");
+  ESP_LOGCONFIG(TAG, "  Input: %s", this->path_.c_str());
+  ESP_LOGCONFIG(TAG, "  Real time: %s", YESNO(this->realtime_));
+  ESP_LOGCONFIG(TAG, "  Repeat: %s", YESNO(this->repeat_));
+}
+
+bool HostMicrophone::open_() {
+  if (this->path_ == "-") {
+    this->fd_ = STDIN_FILENO;
+  } else {
+    this->fd_ = ::open(this->path_.c_str(), O_RDONLY);
+    if (this->fd_ < 0) {
+      ESP_LOGE(TAG, "Could not open %s: %s", this->path_.c_str(), strerror(errno));
+      return false;
+    }
+  }
+
+  // the header is read blocking, only the samples are read as they arrive
+  this->format_ = {16000, 1, 16};
+  if (read_wav_header(this->fd_, this->format_, this->pending_)) {
+    ESP_LOGD(TAG, "Reading WAV with %" PRIu32 " Hz, %u channel(s), %u bits per sample", this->format_.sample_rate,
+             this->format_.channels, this->format_.bits_per_sample);
+  } else if (!this->pending_.empty()) {
+    ESP_LOGD(TAG, "No WAV header, reading raw 16 kHz 16 bit mono samples");
+  } else {
+    ESP_LOGE(TAG, "Could not read a WAV header from %s", this->path_.c_str());
+    this->close_();
+    return false;
+  }
+  if (this->format_.bits_per_sample % 8 != 0 || this->format_.bits_per_sample > 32) {
+    ESP_LOGE(TAG, "Unsupported bits per sample: %u", this->format_.bits_per_sample);
+    this->close_();
+    return false;
+  }
+  if (!this->resampler_.configure(this->format_.sample_rate, SAMPLE_RATE, 1)) {
+    ESP_LOGE(TAG, "Unsupported sample rate: %" PRIu32 " Hz", this->format_.sample_rate);
+    this->close_();
+    return false;
+  }
+  this->data_start_ = lseek(this->fd_, 0, SEEK_CUR) - (off_t) this->pending_.size();
+  fcntl(this->fd_, F_SETFL, fcntl(this->fd_, F_GETFL) | O_NONBLOCK);
+
+  this->partial_ = 0;
+  this->converted_.clear();
+  this->at_end_ = false;
+  return true;
+}
+
+void HostMicrophone::close_() {
+  if (this->fd_ > STDIN_FILENO) {
+    ::close(this->fd_);
+  } else if (this->fd_ == STDIN_FILENO) {
+    fcntl(this->fd_, F_SETFL, fcntl(this->fd_, F_GETFL) & ~O_NONBLOCK);
+  }
+  this->fd_ = -1;
+  this->pending_.clear();
+}
+
+void HostMicrophone::start() {
+  if (this->state_ != microphone::STATE_STOPPED)
+    return;
+  if (!this->open_()) {
+    this->status_set_warning();
+    return;
+  }
+  this->status_clear_warning();
+  this->last_time_ = micros();
+  this->elapsed_us_ = 0;
+  this->samples_read_ = 0;
+  if (!this->realtime_)
+    this->high_freq_.start();
+  this->state_ = microphone::STATE_RUNNING;
+}
+
+void HostMicrophone::stop() {
+  if (this->state_ == microphone::STATE_STOPPED)
+    return;
+  this->elapsed_us_ += micros() - this->last_time_;
+  ESP_LOGD(TAG, "Read %" PRIu64 " samples, %.2f s of audio in %.2f s", this->samples_read_,
+           this->samples_read_ / (float) SAMPLE_RATE, this->elapsed_us_ / 1e6f);
+  this->close_();
+  this->high_freq_.stop();
+  this->state_ = microphone::STATE_STOPPED;
+}
+
+ssize_t HostMicrophone::read_input_(uint8_t *data, size_t len) {
+  size_t from_pending = std::min(len, this->pending_.size());
+  if (from_pending > 0) {
+    memcpy(data, this->pending_.data(), from_pending);
+    this->pending_.erase(this->pending_.begin(), this->pending_.begin() + from_pending);
+    if (from_pending == len)
+      return from_pending;
+  }
+  ssize_t result = ::read(this->fd_, data + from_pending, len - from_pending);
+  if (result < 0)
+    return from_pending > 0 ? (ssize_t) from_pending : (errno == EAGAIN || errno == EINTR ? -1 : 0);
+  return from_pending + result;
+}
+
+size_t HostMicrophone::read(int16_t *buf, size_t len) {
+  if (this->state_ != microphone::STATE_RUNNING || (this->at_end_ && this->converted_.empty()))
+    return 0;
+
+  size_t samples = len / sizeof(int16_t);
+  if (this->realtime_) {
+    uint32_t now = micros();
+    this->elapsed_us_ += now - this->last_time_;
+    this->last_time_ = now;
+    uint64_t due = this->elapsed_us_ * SAMPLE_RATE / 1000000;
+    samples = std::min<uint64_t>(samples, due - std::min(due, this->samples_read_));
+  }
+  if (samples == 0)
+    return 0;
+
+  // input frames for the requested samples, the resampler keeps what it does not use yet
+  size_t frames_wanted = samples;
+  if (!this->resampler_.is_passthrough())
+    frames_wanted = (uint64_t) samples * this->format_.sample_rate / SAMPLE_RATE + 1;
+  if (!this->at_end_ && this->converted_.size() < frames_wanted) {
+    this->read_frames_(frames_wanted - this->converted_.size());
+    if (this->converted_.empty())
+      return 0;
+  }
+
+  size_t consumed;
+  size_t produced = this->resampler_.process(this->converted_.data(), this->converted_.size(), buf, samples, consumed);
+  this->converted_.erase(this->converted_.begin(), this->converted_.begin() + consumed);
+  this->samples_read_ += produced;
+  return produced * sizeof(int16_t);
+}
+
+void HostMicrophone::read_frames_(size_t count) {
+  size_t frame_size = this->format_.get_frame_size();
+  size_t wanted = count * frame_size;
+  if (this->frames_.size() < wanted)
+    this->frames_.resize(wanted);
+  ssize_t result = this->read_input_(this->frames_.data() + this->partial_, wanted - this->partial_);
+  if (result == 0) {
+    if (this->repeat_ && this->data_start_ >= 0 && lseek(this->fd_, this->data_start_, SEEK_SET) >= 0) {
+      this->partial_ = 0;
+      return;
+    }
+    ESP_LOGD(TAG, "End of input after %" PRIu64 " samples", this->samples_read_);
+    this->at_end_ = true;
+    return;
+  }
+  if (result < 0)
+    return;
+
+  size_t total = this->partial_ + result;
+  size_t frames = total / frame_size;
+  size_t start = this->converted_.size();
+  this->converted_.resize(start + frames);
+  int16_t *out = this->converted_.data() + start;
+  if (this->format_.channels == 1) {
+    audio::convert_to_int16(this->frames_.data(), this->format_.bits_per_sample, out, frames);
+  } else {
+    // the first channel of each frame
+    for (size_t i = 0; i < frames; i++)
+      audio::convert_to_int16(this->frames_.data() + i * frame_size, this->format_.bits_per_sample, out + i, 1);
+  }
+  this->partial_ = total - frames * frame_size;
+  memmove(this->frames_.data(), this->frames_.data() + frames * frame_size, this->partial_);
+}
+
+void HostMicrophone::loop() {
+  if (this->state_ != microphone::STATE_RUNNING || this->data_callbacks_.size() == 0)
+    return;
+  std::vector<int16_t> samples;
+  samples.resize(BUFFER_SIZE);
+  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE * sizeof(int16_t));
+  if (bytes_read == 0)
+    return;
+  samples.resize(bytes_read / sizeof(int16_t));
+  this->data_callbacks_.call(samples);
+}
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "esphome/components/audio/audio_convert.h"
+#include "esphome/components/audio/audio_resampler.h"
+#include "esphome/components/host/wav_file.h"
+#include "esphome/components/microphone/microphone.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace esphome {
+namespace host {
+
+/**
+ * Microphone that reads its samples from a WAV file or a pipe, to run audio pipelines on the host.
+ *
+ * Raw input without a WAV header is read as 16 kHz 16 bit mono. Only the first channel is used, and samples are
+ * converted to 16 bits and resampled to 16 kHz, as consumers of a microphone expect. In real time mode samples become
+ * available at their sample rate like on a device, otherwise as fast as they are read, which measures the throughput of
+ * the consumer.
+ */
+class HostMicrophone : public microphone::Microphone, public Component {
+ public:
+  void dump_config() override;
+  void loop() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void start() override;
+  void stop() override;
+
+  size_t read(int16_t *buf, size_t len) override;
+
+  /// Path of the input file, "-" for stdin.
+  void set_path(const std::string &path) { this->path_ = path; }
+  void set_realtime(bool realtime) { this->realtime_ = realtime; }
+  /// Read the file again from the start when its end is reached.
+  void set_repeat(bool repeat) { this->repeat_ = repeat; }
+
+  /// Number of samples read since the microphone was started.
+  uint64_t get_samples_read() const { return this->samples_read_; }
+
+ protected:
+  bool open_();
+  void close_();
+  /**
+   * Reads raw input, starting with the bytes of a WAV header that turned out to be samples.
+   *
+   * @return Number of bytes read, 0 at the end of the input and -1 when nothing arrived yet
+   */
+  ssize_t read_input_(uint8_t *data, size_t len);
+  /// Reads up to count frames of input and adds their first channel to converted_.
+  void read_frames_(size_t count);
+
+  std::string path_;
+  bool realtime_{true};
+  bool repeat_{false};
+
+  int fd_{-1};
+  WavFormat format_{16000, 1, 16};
+  /// Offset of the samples in the file, where reading starts again when repeating.
+  off_t data_start_{0};
+  std::vector<uint8_t> pending_;
+  /// Raw frames read from the input, with a partial frame left at the front.
+  std::vector<uint8_t> frames_;
+  size_t partial_{0};
+  /// 16 bit samples of the first channel at the input rate, waiting to be resampled.
+  std::vector<int16_t> converted_;
+  audio::AudioResampler resampler_;
+  bool at_end_{false};
+
+  uint32_t last_time_{0};
+  /// Time since the microphone was started, which paces the samples in real time mode.
+  uint64_t elapsed_us_{0};
+  uint64_t samples_read_{0};
+
+  HighFrequencyLoopRequester high_freq_;
+};
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,31 @@
+import esphome.codegen as cg
+from esphome.components import speaker
+import esphome.config_validation as cv
+from esphome.const import CONF_FILE, CONF_ID
+
+CONF_BUFFER_DURATION = "buffer_duration"
+CONF_REALTIME = "realtime"
+
+host_ns = cg.esphome_ns.namespace("host")
+HostSpeaker = host_ns.class_("HostSpeaker", speaker.Speaker, cg.Component)
+
+CONFIG_SCHEMA = speaker.SPEAKER_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(HostSpeaker),
+        cv.Required(CONF_FILE): cv.string_strict,
+        cv.Optional(CONF_REALTIME, default=True): cv.boolean,
+        cv.Optional(
+            CONF_BUFFER_DURATION, default="500ms"
+        ): cv.positive_time_period_milliseconds,
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await speaker.register_speaker(var, config)
+
+    cg.add(var.set_path(config[CONF_FILE]))
+    cg.add(var.set_realtime(config[CONF_REALTIME]))
+    cg.add(var.set_buffer_duration(config[CONF_BUFFER_DURATION]))
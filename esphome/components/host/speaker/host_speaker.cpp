@@ -0,0 +1,188 @@
+#ifdef USE_HOST
+
+#include "host_speaker.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace host {
+
+static const char *const TAG = "host.speaker";
+
+void HostSpeaker::dump_config() {
+  ESP_LOGCONFIG(TAG, "Host Speaker:");
+  ESP_LOGCONFIG(TAG, "  Output: %s", this->path_.c_str());
+  ESP_LOGCONFIG(TAG, "  Real time: %s", YESNO(this->realtime_));
+  ESP_LOGCONFIG(TAG, "  Buffer duration: %" PRIu32 " ms", this->buffer_duration_ms_);
+}
+
+bool HostSpeaker::open_() {
+  if (this->path_ == "-") {
+    this->fd_ = STDOUT_FILENO;
+  } else {
+    this->fd_ = ::open(this->path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (this->fd_ < 0) {
+      ESP_LOGE(TAG, "Could not open %s: %s", this->path_.c_str(), strerror(errno));
+      return false;
+    }
+  }
+  // the sizes are filled in when the file is closed, streams get the size for an unknown length
+  this->seekable_ = this->fd_ != STDOUT_FILENO && lseek(this->fd_, 0, SEEK_CUR) >= 0;
+  WavFormat format{this->audio_stream_info_.sample_rate, this->audio_stream_info_.channels,
+                   this->audio_stream_info_.bits_per_sample};
+  if (!write_wav_header(this->fd_, format, this->seekable_ ? 0 : 0xFFFFFFFF)) {
+    ESP_LOGE(TAG, "Could not write the WAV header to %s", this->path_.c_str());
+    this->close_();
+    return false;
+  }
+  return true;
+}
+
+void HostSpeaker::close_() {
+  if (this->fd_ < 0)
+    return;
+  if (this->seekable_ && lseek(this->fd_, 0, SEEK_SET) == 0) {
+    WavFormat format{this->audio_stream_info_.sample_rate, this->audio_stream_info_.channels,
+                     this->audio_stream_info_.bits_per_sample};
+    write_wav_header(this->fd_, format, std::min<uint64_t>(this->written_, 0xFFFFFFFE));
+  }
+  if (this->fd_ != STDOUT_FILENO)
+    ::close(this->fd_);
+  this->fd_ = -1;
+}
+
+void HostSpeaker::start() {
+  this->finishing_ = false;
+  if (this->state_ != speaker::STATE_STOPPED)
+    return;
+  this->bytes_per_second_ = this->audio_stream_info_.sample_rate * this->audio_stream_info_.channels *
+                            this->audio_stream_info_.get_bytes_per_sample();
+  if (this->bytes_per_second_ == 0 || !this->open_()) {
+    this->status_set_warning();
+    return;
+  }
+  this->ring_buffer_ = RingBuffer::create(this->bytes_per_second_ * this->buffer_duration_ms_ / 1000);
+  if (this->ring_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the ring buffer");
+    this->close_();
+    this->status_set_warning();
+    return;
+  }
+  this->status_clear_warning();
+
+  this->played_ = 0;
+  this->written_ = 0;
+  this->last_time_ = micros();
+  this->clock_us_ = 0;
+  this->starved_ = false;
+  this->marks_.clear();
+  this->latency_sum_ = 0;
+  this->latency_count_ = 0;
+  this->max_latency_ = 0;
+  this->underruns_ = 0;
+  if (!this->realtime_)
+    this->high_freq_.start();
+  this->state_ = speaker::STATE_RUNNING;
+}
+
+void HostSpeaker::stop() {
+  if (this->state_ == speaker::STATE_STOPPED)
+    return;
+  ESP_LOGD(TAG, "Wrote %" PRIu64 " bytes, buffered for %.1f ms on average and %.1f ms at most, ran empty %" PRIu32
+           " times",
+           this->written_, this->get_average_latency() / 1000.0f, this->max_latency_ / 1000.0f, this->underruns_);
+  this->close_();
+  this->ring_buffer_.reset();
+  this->marks_.clear();
+  this->finishing_ = false;
+  this->high_freq_.stop();
+  this->state_ = speaker::STATE_STOPPED;
+}
+
+void HostSpeaker::finish() {
+  if (this->state_ == speaker::STATE_RUNNING)
+    this->finishing_ = true;
+}
+
+bool HostSpeaker::has_buffered_data() const {
+  return this->ring_buffer_ != nullptr && this->ring_buffer_->available() > 0;
+}
+
+size_t HostSpeaker::play(const uint8_t *data, size_t length) {
+  if (this->state_ == speaker::STATE_STOPPED)
+    this->start();
+  if (this->state_ != speaker::STATE_RUNNING)
+    return 0;
+  this->finishing_ = false;
+  size_t bytes_written = this->ring_buffer_->write_without_replacement(data, length);
+  if (bytes_written > 0) {
+    this->played_ += bytes_written;
+    this->marks_.push_back({this->played_, micros()});
+  }
+  return bytes_written;
+}
+
+void HostSpeaker::write_due_() {
+  uint32_t now = micros();
+  uint64_t budget = UINT64_MAX;
+  if (this->realtime_) {
+    this->clock_us_ += now - this->last_time_;
+    this->last_time_ = now;
+    uint64_t due = this->clock_us_ * this->bytes_per_second_ / 1000000;
+    budget = due > this->written_ ? due - this->written_ : 0;
+  }
+
+  while (budget > 0) {
+    RingBuffer::ReadSpan span = this->ring_buffer_->acquire_read_span(std::min<uint64_t>(budget, SIZE_MAX));
+    if (span.len == 0)
+      break;
+    ssize_t result = ::write(this->fd_, span.data, span.len);
+    if (result <= 0) {
+      if (errno != EAGAIN && errno != EINTR) {
+        ESP_LOGW(TAG, "Could not write to %s: %s", this->path_.c_str(), strerror(errno));
+        this->status_set_warning();
+      }
+      break;
+    }
+    this->ring_buffer_->release(result);
+    this->written_ += result;
+    budget -= result;
+  }
+
+  while (!this->marks_.empty() && this->marks_.front().end <= this->written_) {
+    uint32_t latency = now - this->marks_.front().time;
+    this->latency_sum_ += latency;
+    this->latency_count_++;
+    this->max_latency_ = std::max(this->max_latency_, latency);
+    this->marks_.pop_front();
+  }
+
+  // audio was due but nothing was buffered, as a device the output would play silence and not catch up afterwards
+  bool starved = budget > 0 && this->ring_buffer_->available() == 0;
+  if (starved && this->realtime_) {
+    if (!this->starved_ && !this->finishing_ && this->written_ > 0)
+      this->underruns_++;
+    this->clock_us_ = this->written_ * 1000000 / this->bytes_per_second_;
+  }
+  this->starved_ = starved;
+}
+
+void HostSpeaker::loop() {
+  if (this->state_ != speaker::STATE_RUNNING)
+    return;
+  this->write_due_();
+  if (this->finishing_ && this->ring_buffer_->available() == 0)
+    this->stop();
+}
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
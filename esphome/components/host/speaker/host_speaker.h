@@ -0,0 +1,91 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "esphome/components/host/wav_file.h"
+#include "esphome/components/speaker/speaker.h"
+#include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace esphome {
+namespace host {
+
+/**
+ * Speaker that writes the played audio to a WAV file or a pipe, to run audio pipelines on the host.
+ *
+ * Played data is buffered like on a device and written out in loop(), at its sample rate in real time mode or as fast
+ * as possible otherwise. The time that played data spends in the buffer is measured, which is the latency the buffer
+ * adds to the pipeline.
+ */
+class HostSpeaker : public speaker::Speaker, public Component {
+ public:
+  void dump_config() override;
+  void loop() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  size_t play(const uint8_t *data, size_t length) override;
+
+  void start() override;
+  void stop() override;
+  void finish() override;
+
+  bool has_buffered_data() const override;
+
+  /// Path of the output file or a named pipe, "-" for stdout, which the logger writes to as well.
+  void set_path(const std::string &path) { this->path_ = path; }
+  void set_realtime(bool realtime) { this->realtime_ = realtime; }
+  void set_buffer_duration(uint32_t buffer_duration_ms) { this->buffer_duration_ms_ = buffer_duration_ms; }
+
+  /// Average and largest time in µs that played data was buffered since the speaker was started.
+  uint32_t get_average_latency() const {
+    return this->latency_count_ == 0 ? 0 : this->latency_sum_ / this->latency_count_;
+  }
+  uint32_t get_max_latency() const { return this->max_latency_; }
+
+ protected:
+  /// When data was played, by the total number of bytes played up to its end.
+  struct PlayMark {
+    uint64_t end;
+    uint32_t time;
+  };
+
+  bool open_();
+  void close_();
+  /// Writes the buffered data that is due to the output.
+  void write_due_();
+
+  std::string path_;
+  bool realtime_{true};
+  uint32_t buffer_duration_ms_{500};
+
+  int fd_{-1};
+  bool seekable_{false};
+  bool finishing_{false};
+  std::unique_ptr<RingBuffer> ring_buffer_;
+  uint32_t bytes_per_second_{0};
+
+  /// Bytes played and written since the speaker was started.
+  uint64_t played_{0};
+  uint64_t written_{0};
+  uint32_t last_time_{0};
+  /// Time of audio that has been due in real time mode, moved back to written_ when the buffer ran empty.
+  uint64_t clock_us_{0};
+  bool starved_{false};
+  std::deque<PlayMark> marks_;
+  uint64_t latency_sum_{0};
+  uint32_t latency_count_{0};
+  uint32_t max_latency_{0};
+  uint32_t underruns_{0};
+
+  HighFrequencyLoopRequester high_freq_;
+};
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,101 @@
+#ifdef USE_HOST
+
+#include "wav_file.h"
+
+#include <cstring>
+#include <unistd.h>
+
+namespace esphome {
+namespace host {
+
+static const uint16_t WAVE_FORMAT_PCM = 1;
+static const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+static bool read_fully(int fd, uint8_t *data, size_t len) {
+  while (len > 0) {
+    ssize_t result = ::read(fd, data, len);
+    if (result <= 0)
+      return false;
+    data += result;
+    len -= result;
+  }
+  return true;
+}
+
+static uint16_t get_le16(const uint8_t *data) { return data[0] | (data[1] << 8); }
+static uint32_t get_le32(const uint8_t *data) { return get_le16(data) | (uint32_t(get_le16(data + 2)) << 16); }
+static void put_le16(uint8_t *data, uint16_t value) {
+  data[0] = value;
+  data[1] = value >> 8;
+}
+static void put_le32(uint8_t *data, uint32_t value) {
+  put_le16(data, value);
+  put_le16(data + 2, value >> 16);
+}
+
+bool read_wav_header(int fd, WavFormat &format, std::vector<uint8_t> &consumed) {
+  uint8_t riff[12];
+  ssize_t len = ::read(fd, riff, sizeof(riff));
+  if (len < 0)
+    len = 0;
+  if (len < (ssize_t) sizeof(riff) || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) {
+    consumed.assign(riff, riff + len);
+    return false;
+  }
+  consumed.clear();
+
+  bool have_format = false;
+  while (true) {
+    uint8_t chunk[8];
+    if (!read_fully(fd, chunk, sizeof(chunk)))
+      return false;
+    uint32_t chunk_size = get_le32(chunk + 4);
+    if (memcmp(chunk, "data", 4) == 0)
+      return have_format;
+    // chunks are padded to an even size
+    size_t remaining = chunk_size + (chunk_size & 1);
+    if (memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16) {
+      uint8_t fmt[16];
+      if (!read_fully(fd, fmt, sizeof(fmt)))
+        return false;
+      remaining -= sizeof(fmt);
+      uint16_t audio_format = get_le16(fmt);
+      if (audio_format != WAVE_FORMAT_PCM && audio_format != WAVE_FORMAT_EXTENSIBLE)
+        return false;
+      format.channels = get_le16(fmt + 2);
+      format.sample_rate = get_le32(fmt + 4);
+      format.bits_per_sample = get_le16(fmt + 14);
+      have_format = format.channels > 0 && format.bits_per_sample >= 8;
+    }
+    // skipped by reading, pipes cannot seek
+    uint8_t skip[64];
+    while (remaining > 0) {
+      size_t n = remaining < sizeof(skip) ? remaining : sizeof(skip);
+      if (!read_fully(fd, skip, n))
+        return false;
+      remaining -= n;
+    }
+  }
+}
+
+bool write_wav_header(int fd, const WavFormat &format, uint32_t data_size) {
+  uint8_t header[44];
+  memcpy(header, "RIFF", 4);
+  put_le32(header + 4, data_size == 0xFFFFFFFF ? data_size : data_size + 36);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  put_le32(header + 16, 16);
+  put_le16(header + 20, WAVE_FORMAT_PCM);
+  put_le16(header + 22, format.channels);
+  put_le32(header + 24, format.sample_rate);
+  put_le32(header + 28, format.sample_rate * format.get_frame_size());
+  put_le16(header + 32, format.get_frame_size());
+  put_le16(header + 34, format.bits_per_sample);
+  memcpy(header + 36, "data", 4);
+  put_le32(header + 40, data_size);
+  return ::write(fd, header, sizeof(header)) == (ssize_t) sizeof(header);
+}
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
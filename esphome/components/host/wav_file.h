@@ -0,0 +1,47 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace host {
+
+/// Format of the PCM samples in a WAV file.
+struct WavFormat {
+  uint32_t sample_rate;
+  uint16_t channels;
+  uint16_t bits_per_sample;
+
+  size_t get_frame_size() const { return this->channels * (this->bits_per_sample / 8); }
+};
+
+/**
+ * Reads the header of a WAV file up to the start of its samples.
+ *
+ * This works on pipes as well, so the file is never rewound. When it does not start with a RIFF WAVE header, false is
+ * returned and the bytes that were already read are left in `consumed`, so the caller can treat them as raw samples.
+ *
+ * @param fd File descriptor to read from
+ * @param format Set to the format of the samples
+ * @param consumed Set to the bytes read when the input is not a WAV file
+ * @return Whether the input is a WAV file with PCM samples
+ */
+bool read_wav_header(int fd, WavFormat &format, std::vector<uint8_t> &consumed);
+
+/**
+ * Writes a WAV header for PCM samples.
+ *
+ * @param fd File descriptor to write to
+ * @param format Format of the samples
+ * @param data_size Number of bytes of samples that follow, 0xFFFFFFFF while that is not known yet
+ * @return Whether the header was written
+ */
+bool write_wav_header(int fd, const WavFormat &format, uint32_t data_size);
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
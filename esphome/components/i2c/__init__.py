@@ -15,6 +15,7 @@ from esphome.const import (
     CONF_I2C_ID,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
 )
 from esphome.core import coroutine_with_priority, CORE
@@ -24,15 +25,21 @@ i2c_ns = cg.esphome_ns.namespace("i2c")
 I2CBus = i2c_ns.class_("I2CBus")
 ArduinoI2CBus = i2c_ns.class_("ArduinoI2CBus", I2CBus, cg.Component)
 IDFI2CBus = i2c_ns.class_("IDFI2CBus", I2CBus, cg.Component)
+HostI2CBus = i2c_ns.class_("HostI2CBus", I2CBus, cg.Component)
 I2CDevice = i2c_ns.class_("I2CDevice")
 
 
 CONF_SDA_PULLUP_ENABLED = "sda_pullup_enabled"
 CONF_SCL_PULLUP_ENABLED = "scl_pullup_enabled"
+CONF_QUEUE_IN_BACKGROUND = "queue_in_background"
+CONF_LATENCY = "latency"
+CONF_DEVICES = "devices"
 MULTI_CONF = True
 
 
 def _bus_declare_type(value):
+    if CORE.is_host:
+        return cv.declare_id(HostI2CBus)(value)
     if CORE.using_arduino:
         return cv.declare_id(ArduinoI2CBus)(value)
     if CORE.using_esp_idf:
@@ -49,11 +56,21 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): _bus_declare_type,
-            cv.Optional(CONF_SDA, default="SDA"): pin_with_input_and_output_support,
+            cv.SplitDefault(
+                CONF_SDA, esp8266="SDA", esp32="SDA", rp2040="SDA"
+            ): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+                pin_with_input_and_output_support,
+            ),
             cv.SplitDefault(CONF_SDA_PULLUP_ENABLED, esp32_idf=True): cv.All(
                 cv.only_with_esp_idf, cv.boolean
             ),
-            cv.Optional(CONF_SCL, default="SCL"): pin_with_input_and_output_support,
+            cv.SplitDefault(
+                CONF_SCL, esp8266="SCL", esp32="SCL", rp2040="SCL"
+            ): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+                pin_with_input_and_output_support,
+            ),
             cv.SplitDefault(CONF_SCL_PULLUP_ENABLED, esp32_idf=True): cv.All(
                 cv.only_with_esp_idf, cv.boolean
             ),
@@ -62,9 +79,18 @@ CONFIG_SCHEMA = cv.All(
             ),
             cv.Optional(CONF_TIMEOUT): cv.positive_time_period,
             cv.Optional(CONF_SCAN, default=True): cv.boolean,
+            cv.Optional(CONF_QUEUE_IN_BACKGROUND): cv.All(
+                cv.only_with_esp_idf, cv.boolean
+            ),
+            cv.Optional(CONF_LATENCY): cv.All(
+                cv.only_on(PLATFORM_HOST), cv.positive_time_period_microseconds
+            ),
+            cv.Optional(CONF_DEVICES): cv.All(
+                cv.only_on(PLATFORM_HOST), cv.ensure_list(cv.i2c_address)
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
-    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_HOST, PLATFORM_RP2040]),
 )
 
 
@@ -74,6 +100,15 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
+    if CORE.is_host:
+        cg.add(var.set_frequency(int(config[CONF_FREQUENCY])))
+        cg.add(var.set_scan(config[CONF_SCAN]))
+        if CONF_LATENCY in config:
+            cg.add(var.set_latency(int(config[CONF_LATENCY].total_microseconds)))
+        for address in config.get(CONF_DEVICES, []):
+            cg.add(var.add_device(address))
+        return
+
     cg.add(var.set_sda_pin(config[CONF_SDA]))
     if CONF_SDA_PULLUP_ENABLED in config:
         cg.add(var.set_sda_pullup_enabled(config[CONF_SDA_PULLUP_ENABLED]))
@@ -85,6 +120,8 @@ async def to_code(config):
     cg.add(var.set_scan(config[CONF_SCAN]))
     if CONF_TIMEOUT in config:
         cg.add(var.set_timeout(int(config[CONF_TIMEOUT].total_microseconds)))
+    if CONF_QUEUE_IN_BACKGROUND in config:
+        cg.add(var.set_queue_in_background(config[CONF_QUEUE_IN_BACKGROUND]))
     if CORE.using_arduino:
         cg.add_library("Wire", None)
 
@@ -41,6 +41,14 @@ ErrorCode I2CDevice::write_register16(uint16_t a_register, const uint8_t *data,
   return bus_->writev(address_, buffers, 2, stop);
 }
 
+void I2CDevice::queue_write_register(uint8_t a_register, const uint8_t *data, size_t len, I2CCallback &&callback) {
+  std::vector<uint8_t> write;
+  write.reserve(len + 1);
+  write.push_back(a_register);
+  write.insert(write.end(), data, data + len);
+  bus_->queue({address_, std::move(write), 0, true, false, std::move(callback)});
+}
+
 bool I2CDevice::read_bytes_16(uint8_t a_register, uint16_t *data, uint8_t len) {
   if (read_register(a_register, reinterpret_cast<uint8_t *>(data), len * 2) != ERROR_OK)
     return false;
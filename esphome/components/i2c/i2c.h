@@ -203,6 +203,23 @@ class I2CDevice {
   /// @return an i2c::ErrorCode
   ErrorCode write_register16(uint16_t a_register, const uint8_t *data, size_t len, bool stop = true);
 
+  /// @brief queues a read of an array of bytes from a specific register in the I²C device, see I2CBus::queue()
+  /// @param a_register an 8 bits internal address of the I²C register to read from
+  /// @param len number of bytes to read
+  /// @param callback called from the main loop with the result and the bytes read
+  /// @param coalesce true allows merging with queued reads of the same or adjacent registers, which requires the
+  /// device to auto-increment the register address on reads
+  void queue_read_register(uint8_t a_register, size_t len, I2CCallback &&callback, bool coalesce = false) {
+    bus_->queue({address_, {a_register}, len, true, coalesce, std::move(callback)});
+  }
+
+  /// @brief queues a write of an array of bytes to a specific register in the I²C device, see I2CBus::queue()
+  /// @param a_register the internal address of the register to write to
+  /// @param data pointer to the bytes to write, they are copied
+  /// @param len number of bytes to write
+  /// @param callback called from the main loop with the result, can be empty
+  void queue_write_register(uint8_t a_register, const uint8_t *data, size_t len, I2CCallback &&callback = nullptr);
+
   ///
   /// Compat APIs
   /// All methods below have been added for compatibility reasons. They do not bring any functionality and therefore on
@@ -0,0 +1,157 @@
+#include "i2c_bus.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c";
+
+/// Largest read that queued reads of adjacent registers are merged into.
+static const size_t MAX_COALESCED_READ = 32;
+
+void I2CBus::queue(I2CTransaction &&transaction) {
+  if (!this->queue_processed_) {
+    std::vector<uint8_t> data;
+    ErrorCode result;
+    this->run_transaction_(transaction, data, result);
+    if (transaction.callback)
+      transaction.callback(result, result == ERROR_OK ? data.data() : nullptr, result == ERROR_OK ? data.size() : 0);
+    return;
+  }
+  {
+    LockGuard guard(this->queue_lock_);
+    if (transaction.coalesce && this->coalesce_(transaction))
+      return;
+    auto item = make_unique<QueuedTransaction>();
+    item->completions.push_back({0, transaction.read_len, std::move(transaction.callback)});
+    item->transaction = std::move(transaction);
+    this->queue_pending_.push_back(std::move(item));
+  }
+#ifdef USE_ESP32
+  if (this->queue_task_handle_ != nullptr)
+    xTaskNotifyGive(this->queue_task_handle_);
+#endif
+}
+
+size_t I2CBus::get_queue_length() {
+  LockGuard guard(this->queue_lock_);
+  return this->queue_pending_.size() + this->queue_running_ + this->queue_done_.size();
+}
+
+bool I2CBus::coalesce_(I2CTransaction &transaction) {
+  if (transaction.write.size() != 1 || transaction.read_len == 0)
+    return false;
+  uint8_t a_register = transaction.write[0];
+  for (auto it = this->queue_pending_.rbegin(); it != this->queue_pending_.rend(); ++it) {
+    QueuedTransaction &item = **it;
+    I2CTransaction &queued = item.transaction;
+    if (queued.address != transaction.address)
+      continue;
+    // only the last queued transaction of the device can be extended, anything else would reorder its transactions
+    if (!queued.coalesce || queued.write.size() != 1 || queued.read_len == 0 || queued.stop != transaction.stop ||
+        a_register < queued.write[0])
+      return false;
+    size_t offset = a_register - queued.write[0];
+    size_t end = offset + transaction.read_len;
+    if (offset > queued.read_len || end > MAX_COALESCED_READ || queued.write[0] + end > 256)
+      return false;
+    queued.read_len = std::max(queued.read_len, end);
+    item.completions.push_back({offset, transaction.read_len, std::move(transaction.callback)});
+    ESP_LOGVV(TAG, "Merged read of 0x%02X register 0x%02X into read of %zu bytes", transaction.address, a_register,
+              queued.read_len);
+    return true;
+  }
+  return false;
+}
+
+bool I2CBus::run_next_transaction_() {
+  std::unique_ptr<QueuedTransaction> item;
+  {
+    LockGuard guard(this->queue_lock_);
+    if (this->queue_pending_.empty())
+      return false;
+    item = std::move(this->queue_pending_.front());
+    this->queue_pending_.pop_front();
+    this->queue_running_++;
+  }
+  this->run_transaction_(item->transaction, item->data, item->result);
+  {
+    LockGuard guard(this->queue_lock_);
+    this->queue_running_--;
+    this->queue_done_.push_back(std::move(item));
+  }
+  return true;
+}
+
+void I2CBus::run_transaction_(I2CTransaction &transaction, std::vector<uint8_t> &data, ErrorCode &result) {
+  data.resize(transaction.read_len);
+  if (!transaction.write.empty() && transaction.read_len > 0 && !transaction.stop) {
+    result = this->write_read_(transaction.address, transaction.write.data(), transaction.write.size(), data.data(),
+                               data.size());
+    return;
+  }
+  result = ERROR_OK;
+  if (!transaction.write.empty() || transaction.read_len == 0) {
+    result = this->write(transaction.address, transaction.write.data(), transaction.write.size(),
+                         transaction.stop || transaction.read_len == 0);
+  }
+  if (result == ERROR_OK && transaction.read_len > 0)
+    result = this->read(transaction.address, data.data(), data.size());
+}
+
+void I2CBus::process_queue_(uint32_t budget_us) {
+#ifdef USE_ESP32
+  bool run_here = this->queue_task_handle_ == nullptr;
+#else
+  bool run_here = true;
+#endif
+  if (run_here) {
+    uint32_t start = micros();
+    while (this->run_next_transaction_()) {
+      if (micros() - start >= budget_us)
+        break;
+    }
+  }
+
+  std::vector<std::unique_ptr<QueuedTransaction>> done;
+  {
+    LockGuard guard(this->queue_lock_);
+    if (this->queue_done_.empty())
+      return;
+    done.swap(this->queue_done_);
+  }
+  // the callbacks may queue new transactions, so they are called without holding the lock
+  for (auto &item : done) {
+    bool ok = item->result == ERROR_OK;
+    for (auto &completion : item->completions) {
+      if (!completion.callback)
+        continue;
+      if (ok) {
+        completion.callback(ERROR_OK, item->data.data() + completion.offset, completion.len);
+      } else {
+        completion.callback(item->result, nullptr, 0);
+      }
+    }
+  }
+}
+
+#ifdef USE_ESP32
+bool I2CBus::start_queue_task_(uint32_t stack_size, unsigned priority) {
+  return xTaskCreate(I2CBus::queue_task_, "i2c_queue", stack_size, this, priority, &this->queue_task_handle_) ==
+         pdPASS;
+}
+
+void I2CBus::queue_task_(void *arg) {
+  auto *bus = static_cast<I2CBus *>(arg);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (bus->run_next_transaction_()) {
+    }
+  }
+}
+#endif
+
+}  // namespace i2c
+}  // namespace esphome
@@ -1,8 +1,18 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
+#include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
 
 namespace esphome {
 namespace i2c {
@@ -32,6 +42,22 @@ struct WriteBuffer {
   size_t len;           ///< length of the buffer
 };
 
+/// @brief Called from the main loop when a queued transaction has completed
+/// @param err result of the transaction
+/// @param data bytes read from the device, only valid during the call
+/// @param len number of bytes read
+using I2CCallback = std::function<void(ErrorCode err, const uint8_t *data, size_t len)>;
+
+/// @brief A transaction for I2CBus::queue(): an optional write followed by an optional read
+struct I2CTransaction {
+  uint8_t address;             ///< address of the I²C component on the i2c bus
+  std::vector<uint8_t> write;  ///< bytes written first, usually the register address
+  size_t read_len;             ///< number of bytes read after the write, can be 0
+  bool stop;                   ///< send a stop after the write instead of a restart
+  bool coalesce;               ///< may be merged with queued reads of the same or adjacent registers
+  I2CCallback callback;        ///< called with the result, can be empty
+};
+
 /// @brief This Class provides the methods to read and write bytes from an I2CBus.
 /// @note The I2CBus virtual class follows a *Factory design pattern* that provides all the interfaces methods required
 /// by clients while deferring the actual implementation of these methods to a subclasses. I2C-bus specification and
@@ -91,7 +117,65 @@ class I2CBus {
   /// @details This is a pure virtual method that must be implemented in the subclass.
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t count, bool stop) = 0;
 
+  /// @brief Queues a transaction instead of running it right away. Queued transactions run in order from the loop of
+  /// the bus, or from a background task where the bus supports it, and their callbacks are called from the main loop.
+  /// @param transaction the transaction to queue
+  /// @details A read with coalesce set that starts with a single register address byte is merged with a queued read of
+  /// the same device that it extends or that already covers it, so the device must auto-increment its register
+  /// address on reads. Buses that don't process a queue run the transaction and call the callback right away. With a
+  /// background task, a write and read without stop run as one transfer, but with stop set a transfer from the main
+  /// loop can run in between, so such a device must not also be used synchronously.
+  void queue(I2CTransaction &&transaction);
+
+  /// @brief Number of queued transactions that haven't completed yet
+  size_t get_queue_length();
+
  protected:
+  /// @brief A queued transaction and the callbacks of all transactions merged into it
+  struct QueuedTransaction {
+    struct Completion {
+      size_t offset;  ///< position of the data of this callback in the data read
+      size_t len;     ///< number of bytes for this callback
+      I2CCallback callback;
+    };
+    I2CTransaction transaction;
+    std::vector<Completion> completions;
+    std::vector<uint8_t> data;
+    ErrorCode result{ERROR_OK};
+  };
+
+  /// @brief Time the loop of the bus spends on running queued transactions
+  static const uint32_t QUEUE_TIME_BUDGET_US = 10000;
+
+  /// @brief Runs queued transactions for up to budget_us (unless a background task does that) and calls the callbacks
+  /// of the completed ones. Called from the loop of the bus.
+  void process_queue_(uint32_t budget_us);
+  /// @brief Runs the next queued transaction, returns false if the queue was empty
+  bool run_next_transaction_();
+  /// @brief Runs the write and read of a transaction and stores the bytes read in data
+  void run_transaction_(I2CTransaction &transaction, std::vector<uint8_t> &data, ErrorCode &result);
+  /// @brief Writes and then reads after a restart. Buses that run queued transactions from a task override this to do
+  /// both in one transfer, so that no transfer from the main loop can run in between.
+  virtual ErrorCode write_read_(uint8_t address, const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+                                size_t read_len) {
+    ErrorCode err = this->write(address, write_buffer, write_len, false);
+    return err != ERROR_OK ? err : this->read(address, read_buffer, read_len);
+  }
+  /// @brief Merges the transaction into a queued one if it may, returns true if it did
+  bool coalesce_(I2CTransaction &transaction);
+#ifdef USE_ESP32
+  /// @brief Starts a task that runs the queued transactions, the bus must be safe to use from several tasks
+  bool start_queue_task_(uint32_t stack_size, unsigned priority);
+  static void queue_task_(void *arg);
+  TaskHandle_t queue_task_handle_{nullptr};
+#endif
+
+  Mutex queue_lock_;
+  std::deque<std::unique_ptr<QueuedTransaction>> queue_pending_;  ///< transactions waiting to run
+  std::vector<std::unique_ptr<QueuedTransaction>> queue_done_;    ///< transactions waiting for their callbacks
+  size_t queue_running_{0};                                       ///< transactions being run right now
+  bool queue_processed_{false};  ///< set by buses that call process_queue_() from their loop
+
   /// @brief Scans the I2C bus for devices. Devices presence is kept in an array of std::pair
   /// that contains the address and the corresponding bool presence flag.
   void i2c_scan_() {
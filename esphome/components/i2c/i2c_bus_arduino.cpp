@@ -38,12 +38,15 @@ void ArduinoI2CBus::setup() {
   this->set_pins_and_clock_();
 
   this->initialized_ = true;
+  this->queue_processed_ = true;
   if (this->scan_) {
     ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
     this->i2c_scan_();
   }
 }
 
+void ArduinoI2CBus::loop() { this->process_queue_(QUEUE_TIME_BUDGET_US); }
+
 void ArduinoI2CBus::set_pins_and_clock_() {
 #ifdef USE_RP2040
   wire_->setSDA(this->sda_pin_);
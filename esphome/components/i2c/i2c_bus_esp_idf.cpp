@@ -13,6 +13,9 @@ namespace i2c {
 
 static const char *const TAG = "i2c.idf";
 
+static const uint32_t QUEUE_TASK_STACK_SIZE = 3072;
+static const unsigned QUEUE_TASK_PRIORITY = 5;
+
 void IDFI2CBus::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2C bus...");
   static i2c_port_t next_port = I2C_NUM_0;
@@ -66,11 +69,19 @@ void IDFI2CBus::setup() {
     return;
   }
   initialized_ = true;
+  // the driver serializes its commands, and a queued write and read is a single command (see write_read_()), which
+  // makes it safe to run queued transactions from a task
+  if (this->queue_in_background_ && !this->start_queue_task_(QUEUE_TASK_STACK_SIZE, QUEUE_TASK_PRIORITY)) {
+    ESP_LOGW(TAG, "Could not start the task for queued transactions, running them from the main loop");
+  }
+  this->queue_processed_ = true;
   if (this->scan_) {
     ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
     this->i2c_scan_();
   }
 }
+
+void IDFI2CBus::loop() { this->process_queue_(QUEUE_TIME_BUDGET_US); }
 void IDFI2CBus::dump_config() {
   ESP_LOGCONFIG(TAG, "I2C Bus:");
   ESP_LOGCONFIG(TAG, "  SDA Pin: GPIO%u", this->sda_pin_);
@@ -79,6 +90,9 @@ void IDFI2CBus::dump_config() {
   if (timeout_ > 0) {
     ESP_LOGCONFIG(TAG, "  Timeout: %" PRIu32 "us", this->timeout_);
   }
+  if (this->queue_task_handle_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Queued transactions: in background task");
+  }
   switch (this->recovery_result_) {
     case RECOVERY_COMPLETED:
       ESP_LOGCONFIG(TAG, "  Recovery: bus successfully recovered");
@@ -245,6 +259,48 @@ ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, b
   return ERROR_OK;
 }
 
+ErrorCode IDFI2CBus::write_read_(uint8_t address, const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+                                 size_t read_len) {
+  if (!initialized_) {
+    ESP_LOGVV(TAG, "i2c bus not initialized!");
+    return ERROR_NOT_INITIALIZED;
+  }
+  // write, restart and read in one command, so that the driver runs no other command in between
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+  esp_err_t err = i2c_master_start(cmd);
+  if (err == ESP_OK)
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, true);
+  if (err == ESP_OK)
+    err = i2c_master_write(cmd, write_buffer, write_len, true);
+  if (err == ESP_OK)
+    err = i2c_master_start(cmd);
+  if (err == ESP_OK)
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, true);
+  if (err == ESP_OK)
+    err = i2c_master_read(cmd, read_buffer, read_len, I2C_MASTER_LAST_NACK);
+  if (err == ESP_OK)
+    err = i2c_master_stop(cmd);
+  if (err != ESP_OK) {
+    ESP_LOGVV(TAG, "TX/RX with %02X command failed: %s", address, esp_err_to_name(err));
+    i2c_cmd_link_delete(cmd);
+    return ERROR_UNKNOWN;
+  }
+  err = i2c_master_cmd_begin(port_, cmd, 20 / portTICK_PERIOD_MS);
+  i2c_cmd_link_delete(cmd);
+  if (err == ESP_FAIL) {
+    // transfer not acked
+    ESP_LOGVV(TAG, "TX/RX with %02X failed: not acked", address);
+    return ERROR_NOT_ACKNOWLEDGED;
+  } else if (err == ESP_ERR_TIMEOUT) {
+    ESP_LOGVV(TAG, "TX/RX with %02X failed: timeout", address);
+    return ERROR_TIMEOUT;
+  } else if (err != ESP_OK) {
+    ESP_LOGVV(TAG, "TX/RX with %02X failed: %s", address, esp_err_to_name(err));
+    return ERROR_UNKNOWN;
+  }
+  return ERROR_OK;
+}
+
 /// Perform I2C bus recovery, see:
 /// https://www.nxp.com/docs/en/user-guide/UM10204.pdf
 /// https://www.analog.com/media/en/technical-documentation/application-notes/54305147357414AN686_0.pdf
@@ -18,6 +18,7 @@ enum RecoveryCode {
 class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
@@ -30,12 +31,16 @@ class IDFI2CBus : public I2CBus, public Component {
   void set_scl_pullup_enabled(bool scl_pullup_enabled) { scl_pullup_enabled_ = scl_pullup_enabled; }
   void set_frequency(uint32_t frequency) { frequency_ = frequency; }
   void set_timeout(uint32_t timeout) { timeout_ = timeout; }
+  void set_queue_in_background(bool queue_in_background) { queue_in_background_ = queue_in_background; }
 
  private:
   void recover_();
   RecoveryCode recovery_result_;
 
  protected:
+  ErrorCode write_read_(uint8_t address, const uint8_t *write_buffer, size_t write_len, uint8_t *read_buffer,
+                        size_t read_len) override;
+
   i2c_port_t port_;
   uint8_t sda_pin_;
   bool sda_pullup_enabled_;
@@ -44,6 +49,7 @@ class IDFI2CBus : public I2CBus, public Component {
   uint32_t frequency_;
   uint32_t timeout_ = 0;
   bool initialized_ = false;
+  bool queue_in_background_ = false;
 };
 
 }  // namespace i2c
@@ -0,0 +1,104 @@
+#ifdef USE_HOST
+
+#include "i2c_bus_host.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <cinttypes>
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c.host";
+
+void HostI2CBus::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up simulated I2C bus...");
+  // devices added by the configuration are the only ones that acknowledge
+  this->any_address_ = this->devices_.empty();
+  this->queue_processed_ = true;
+  if (this->scan_) {
+    ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
+    this->i2c_scan_();
+  }
+  this->transfer_count_ = 0;
+  this->busy_time_ = 0;
+}
+
+void HostI2CBus::loop() { this->process_queue_(QUEUE_TIME_BUDGET_US); }
+
+void HostI2CBus::dump_config() {
+  ESP_LOGCONFIG(TAG, "I2C Bus (simulated):");
+  ESP_LOGCONFIG(TAG, "  Frequency: %" PRIu32 " Hz", this->frequency_);
+  ESP_LOGCONFIG(TAG, "  Latency: %" PRIu32 "us", this->latency_);
+  if (this->any_address_) {
+    ESP_LOGCONFIG(TAG, "  Devices: any address");
+  } else {
+    for (const auto &device : this->devices_)
+      ESP_LOGCONFIG(TAG, "  Device: 0x%02X", device.address);
+  }
+}
+
+uint8_t *HostI2CBus::get_registers(uint8_t address) {
+  Device *device = this->find_device_(address, false);
+  return device == nullptr ? nullptr : device->registers.data();
+}
+
+HostI2CBus::Device *HostI2CBus::find_device_(uint8_t address, bool create) {
+  for (auto &device : this->devices_) {
+    if (device.address == address)
+      return &device;
+  }
+  if (!create)
+    return nullptr;
+  this->devices_.push_back({.address = address, .pointer = 0, .registers = {}});
+  return &this->devices_.back();
+}
+
+void HostI2CBus::simulate_transfer_(size_t len) {
+  // 9 bits per byte including the acknowledge, plus the address byte
+  uint64_t duration = this->latency_ + (len + 1) * 9 * 1000000ULL / this->frequency_;
+  this->transfer_count_++;
+  this->busy_time_ += duration;
+  delayMicroseconds(duration);
+}
+
+ErrorCode HostI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
+  size_t len = 0;
+  for (size_t i = 0; i < cnt; i++)
+    len += buffers[i].len;
+  this->simulate_transfer_(len);
+  Device *device = this->find_device_(address, this->any_address_);
+  if (device == nullptr)
+    return ERROR_NOT_ACKNOWLEDGED;
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < buffers[i].len; j++)
+      buffers[i].data[j] = device->registers[device->pointer++];
+  }
+  return ERROR_OK;
+}
+
+ErrorCode HostI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) {
+  size_t len = 0;
+  for (size_t i = 0; i < cnt; i++)
+    len += buffers[i].len;
+  this->simulate_transfer_(len);
+  Device *device = this->find_device_(address, this->any_address_);
+  if (device == nullptr)
+    return ERROR_NOT_ACKNOWLEDGED;
+  bool first = true;
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < buffers[i].len; j++) {
+      if (first) {
+        device->pointer = buffers[i].data[j];
+        first = false;
+      } else {
+        device->registers[device->pointer++] = buffers[i].data[j];
+      }
+    }
+  }
+  return ERROR_OK;
+}
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
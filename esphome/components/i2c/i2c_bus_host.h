@@ -0,0 +1,62 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "i2c_bus.h"
+#include "esphome/core/component.h"
+#include <array>
+#include <deque>
+
+namespace esphome {
+namespace i2c {
+
+/// @brief Simulated I2C bus for the host platform.
+/// @details Every device is a file of 256 registers. The first byte of a write selects the register, reads and the
+/// remaining bytes of the write continue at the selected register and increment it. Each transfer blocks for the
+/// configured latency plus the time its bytes take at the bus frequency, which makes the bus useful to benchmark how
+/// components use it. Without any configured devices every address acknowledges.
+class HostI2CBus : public I2CBus, public Component {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
+  ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  void set_scan(bool scan) { scan_ = scan; }
+  void set_frequency(uint32_t frequency) { frequency_ = frequency; }
+  void set_latency(uint32_t latency) { latency_ = latency; }
+  void add_device(uint8_t address) { this->find_device_(address, true); }
+
+  /// @brief the registers of a simulated device, e.g. to set the values a component reads, nullptr if it doesn't exist
+  uint8_t *get_registers(uint8_t address);
+  /// @brief number of transfers since setup, including failed ones
+  uint32_t get_transfer_count() const { return this->transfer_count_; }
+  /// @brief time in µs the simulated transfers took since setup
+  uint64_t get_busy_time() const { return this->busy_time_; }
+
+ protected:
+  struct Device {
+    uint8_t address;
+    uint8_t pointer;
+    std::array<uint8_t, 256> registers;
+  };
+
+  Device *find_device_(uint8_t address, bool create);
+  /// @brief blocks for the time a transfer of len bytes after the address takes
+  void simulate_transfer_(size_t len);
+
+  /// a deque, so the registers returned by get_registers() stay valid when devices are added
+  std::deque<Device> devices_;
+  bool any_address_{true};
+  uint32_t frequency_{50000};
+  uint32_t latency_{0};
+  uint32_t transfer_count_{0};
+  uint64_t busy_time_{0};
+};
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -5,6 +5,7 @@
 #include <driver/i2s.h>
 
 #include "esphome/components/audio/audio.h"
+#include "esphome/components/audio/audio_convert.h"
 
 #include "esphome/core/application.h"
 #include "esphome/core/hal.h"
@@ -60,35 +61,6 @@ static esp_err_t err_bit_to_esp_err(uint32_t bit) {
   }
 }
 
-/// @brief Multiplies the input array of Q15 numbers by a Q15 constant factor
-///
-/// Based on `dsps_mulc_s16_ansi` from the esp-dsp library:
-/// https://github.com/espressif/esp-dsp/blob/master/modules/math/mulc/fixed/dsps_mulc_s16_ansi.c
-/// (accessed on 2024-09-30).
-/// @param input Array of Q15 numbers
-/// @param output Array of Q15 numbers
-/// @param len Length of array
-/// @param c Q15 constant factor
-static void q15_multiplication(const int16_t *input, int16_t *output, size_t len, int16_t c) {
-  for (int i = 0; i < len; i++) {
-    int32_t acc = (int32_t) input[i] * (int32_t) c;
-    output[i] = (int16_t) (acc >> 15);
-  }
-}
-
-// Lists the Q15 fixed point scaling factor for volume reduction.
-// Has 100 values representing silence and a reduction [49, 48.5, ... 0.5, 0] dB.
-// dB to PCM scaling factor formula: floating_point_scale_factor = 2^(-db/6.014)
-// float to Q15 fixed point formula: q15_scale_factor = floating_point_scale_factor * 2^(15)
-static const std::vector<int16_t> Q15_VOLUME_SCALING_FACTORS = {
-    0,     116,   122,   130,   137,   146,   154,   163,   173,   183,   194,   206,   218,   231,   244,
-    259,   274,   291,   308,   326,   345,   366,   388,   411,   435,   461,   488,   517,   548,   580,
-    615,   651,   690,   731,   774,   820,   868,   920,   974,   1032,  1094,  1158,  1227,  1300,  1377,
-    1459,  1545,  1637,  1734,  1837,  1946,  2061,  2184,  2313,  2450,  2596,  2750,  2913,  3085,  3269,
-    3462,  3668,  3885,  4116,  4360,  4619,  4893,  5183,  5490,  5816,  6161,  6527,  6914,  7324,  7758,
-    8218,  8706,  9222,  9770,  10349, 10963, 11613, 12302, 13032, 13805, 14624, 15491, 16410, 17384, 18415,
-    19508, 20665, 21891, 23189, 24565, 26022, 27566, 29201, 30933, 32767};
-
 void I2SAudioSpeaker::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2S Audio Speaker...");
 
@@ -162,8 +134,7 @@ void I2SAudioSpeaker::set_volume(float volume) {
 #endif
   {
     // Fallback to software volume control by using a Q15 fixed point scaling factor
-    ssize_t decibel_index = remap<ssize_t, float>(volume, 0.0f, 1.0f, 0, Q15_VOLUME_SCALING_FACTORS.size() - 1);
-    this->q15_volume_factor_ = Q15_VOLUME_SCALING_FACTORS[decibel_index];
+    this->q15_volume_factor_ = audio::volume_to_q15(volume);
   }
 }
 
@@ -291,8 +262,8 @@ void I2SAudioSpeaker::speaker_task(void *params) {
 
         if ((audio_stream_info.bits_per_sample == 16) && (this_speaker->q15_volume_factor_ < INT16_MAX)) {
           // Scale samples by the volume factor in place
-          q15_multiplication((int16_t *) this_speaker->data_buffer_, (int16_t *) this_speaker->data_buffer_,
-                             bytes_read / sizeof(int16_t), this_speaker->q15_volume_factor_);
+          audio::scale_audio_samples((int16_t *) this_speaker->data_buffer_, (int16_t *) this_speaker->data_buffer_,
+                                     bytes_read / sizeof(int16_t), this_speaker->q15_volume_factor_);
         }
 
         if (audio_stream_info.bits_per_sample == (uint8_t) this_speaker->bits_per_sample_) {
@@ -1,66 +1,134 @@
 #include "image.h"
 
 #include "esphome/core/hal.h"
+#include <algorithm>
 
 namespace esphome {
 namespace image {
 
+/// Number of pixels the row blitters convert at once.
+static const int ROW_CHUNK_SIZE = 64;
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
-  switch (type_) {
-    case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
-          }
-        }
-      }
-      break;
-    }
-    case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
-      break;
-    case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
+  // clip to the display and its clipping rectangle once, so only the visible part of the image is converted
+  int x_start = std::max(0, -x);
+  int x_end = std::min(this->width_, display->get_width() - x);
+  int y_start = std::max(0, -y);
+  int y_end = std::min(this->height_, display->get_height() - y);
+  display::Rect clipping = display->get_clipping();
+  if (clipping.is_set()) {
+    // the clipping rectangle includes its right and bottom edges
+    x_start = std::max(x_start, clipping.x - x);
+    x_end = std::min(x_end, clipping.x2() + 1 - x);
+    y_start = std::max(y_start, clipping.y - y);
+    y_end = std::min(y_end, clipping.y2() + 1 - y);
+  }
+
+  Color colors[ROW_CHUNK_SIZE];
+  bool visible[ROW_CHUNK_SIZE];
+  for (int img_y = y_start; img_y < y_end; img_y++) {
+    for (int img_x = x_start; img_x < x_end; img_x += ROW_CHUNK_SIZE) {
+      const int count = std::min(ROW_CHUNK_SIZE, x_end - img_x);
+      switch (this->type_) {
+        case IMAGE_TYPE_BINARY:
+          this->blit_binary_row_(img_x, img_y, count, colors, visible, color_on, color_off);
+          break;
+        case IMAGE_TYPE_GRAYSCALE:
+          this->blit_grayscale_row_(img_x, img_y, count, colors, visible);
+          break;
+        case IMAGE_TYPE_RGB565:
+          this->blit_rgb565_row_(img_x, img_y, count, colors, visible);
+          break;
+        case IMAGE_TYPE_RGB24:
+          this->blit_rgb24_row_(img_x, img_y, count, colors, visible);
+          break;
+        case IMAGE_TYPE_RGBA:
+          this->blit_rgba_row_(img_x, img_y, count, colors, visible);
+          break;
+        default:
+          return;
       }
-      break;
-    case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
+      // hand each run of drawn pixels to the display at once
+      int run_start = 0;
+      while (run_start != count) {
+        if (!visible[run_start]) {
+          run_start++;
+          continue;
         }
+        int run_end = run_start + 1;
+        while (run_end != count && visible[run_end])
+          run_end++;
+        display->draw_pixel_row_at(x + img_x + run_start, y + img_y, colors + run_start, run_end - run_start);
+        run_start = run_end;
       }
-      break;
-    case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
-      break;
+    }
+  }
+}
+
+void Image::blit_binary_row_(int x, int y, int count, Color *colors, bool *visible, Color color_on,
+                             Color color_off) const {
+  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
+  const uint32_t pos = x + y * width_8;
+  const uint8_t *data = this->data_start_ + pos / 8u;
+  uint8_t mask = 0x80 >> (pos % 8u);
+  uint8_t bits = progmem_read_byte(data);
+  for (int i = 0; i != count; i++) {
+    bool on = bits & mask;
+    colors[i] = on ? color_on : color_off;
+    visible[i] = on || !this->transparent_;
+    mask >>= 1;
+    if (mask == 0 && i + 1 != count) {
+      mask = 0x80;
+      bits = progmem_read_byte(++data);
+    }
+  }
+}
+
+void Image::blit_grayscale_row_(int x, int y, int count, Color *colors, bool *visible) const {
+  const uint8_t *data = this->data_start_ + x + y * this->width_;
+  for (int i = 0; i != count; i++) {
+    const uint8_t gray = progmem_read_byte(data + i);
+    // gray level 1 has been defined as transparent color
+    visible[i] = gray != 1 || !this->transparent_;
+    colors[i] = Color(gray, gray, gray, visible[i] ? 0xFF : 0);
+  }
+}
+
+void Image::blit_rgb565_row_(int x, int y, int count, Color *colors, bool *visible) const {
+  const uint32_t bytes_per_pixel = this->transparent_ ? 3 : 2;
+  const uint8_t *data = this->data_start_ + (x + y * this->width_) * bytes_per_pixel;
+  for (int i = 0; i != count; i++, data += bytes_per_pixel) {
+    uint16_t rgb565 = encode_uint16(progmem_read_byte(data), progmem_read_byte(data + 1));
+    auto r = (rgb565 & 0xF800) >> 11;
+    auto g = (rgb565 & 0x07E0) >> 5;
+    auto b = rgb565 & 0x001F;
+    uint8_t a = this->transparent_ ? progmem_read_byte(data + 2) : 0xFF;
+    colors[i] = Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), a);
+    visible[i] = a >= 0x80;
+  }
+}
+
+void Image::blit_rgb24_row_(int x, int y, int count, Color *colors, bool *visible) const {
+  const uint8_t *data = this->data_start_ + (x + y * this->width_) * 3;
+  for (int i = 0; i != count; i++, data += 3) {
+    Color color(progmem_read_byte(data), progmem_read_byte(data + 1), progmem_read_byte(data + 2), 0xFF);
+    // (0, 0, 1) has been defined as transparent color for non-alpha images.
+    if (color.b == 1 && color.r == 0 && color.g == 0 && this->transparent_)
+      color.w = 0;
+    colors[i] = color;
+    visible[i] = color.w != 0;
   }
 }
+
+void Image::blit_rgba_row_(int x, int y, int count, Color *colors, bool *visible) const {
+  const uint8_t *data = this->data_start_ + (x + y * this->width_) * 4;
+  for (int i = 0; i != count; i++, data += 4) {
+    colors[i] = Color(progmem_read_byte(data), progmem_read_byte(data + 1), progmem_read_byte(data + 2),
+                      progmem_read_byte(data + 3));
+    visible[i] = colors[i].w >= 0x80;
+  }
+}
+
 Color Image::get_pixel(int x, int y, Color color_on, Color color_off) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return color_off;
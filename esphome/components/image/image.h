@@ -54,6 +54,13 @@ class Image : public display::BaseImage {
   lv_img_dsc_t *get_lv_img_dsc();
 #endif
  protected:
+  /// Convert count pixels of row y starting at x, and flag the ones that are drawn rather than transparent.
+  void blit_binary_row_(int x, int y, int count, Color *colors, bool *visible, Color color_on, Color color_off) const;
+  void blit_grayscale_row_(int x, int y, int count, Color *colors, bool *visible) const;
+  void blit_rgb565_row_(int x, int y, int count, Color *colors, bool *visible) const;
+  void blit_rgb24_row_(int x, int y, int count, Color *colors, bool *visible) const;
+  void blit_rgba_row_(int x, int y, int count, Color *colors, bool *visible) const;
+
   bool get_binary_pixel_(int x, int y) const;
   Color get_rgb24_pixel_(int x, int y) const;
   Color get_rgba_pixel_(int x, int y) const;
@@ -31,6 +31,9 @@ std::string build_json(const json_build_t &f) {
   const size_t free_heap = rp2040.getFreeHeap();
 #elif defined(USE_LIBRETINY)
   const size_t free_heap = lt_heap_get_free();
+#elif defined(USE_HOST)
+  // no practical limit, but keep the document size bounded
+  const size_t free_heap = 1024 * 1024;
 #endif
 
   size_t request_size = std::min(free_heap, (size_t) 512);
@@ -75,6 +78,9 @@ bool parse_json(const std::string &data, const json_parse_t &f) {
   const size_t free_heap = rp2040.getFreeHeap();
 #elif defined(USE_LIBRETINY)
   const size_t free_heap = lt_heap_get_free();
+#elif defined(USE_HOST)
+  // no practical limit, but keep the document size bounded
+  const size_t free_heap = 1024 * 1024;
 #endif
   size_t request_size = std::min(free_heap, (size_t) (data.size() * 1.5));
   while (true) {
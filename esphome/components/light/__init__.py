@@ -33,7 +33,7 @@ from esphome.const import (
     CONF_WHITE,
 )
 from esphome.core import coroutine_with_priority
-from esphome.cpp_helpers import setup_entity
+from esphome.cpp_helpers import register_platform_entity, setup_entity
 
 from .automation import LIGHT_STATE_SCHEMA
 from .effects import (
@@ -219,6 +219,7 @@ async def setup_light_core_(light_var, output_var, config):
 async def register_light(output_var, config):
     light_var = cg.new_Pvariable(config[CONF_ID], output_var)
     cg.add(cg.App.register_light(light_var))
+    register_platform_entity("light", config)
     await cg.register_component(light_var, config)
     await setup_light_core_(light_var, output_var, config)
 
@@ -132,6 +132,10 @@ void LightState::loop() {
     this->next_write_ = false;
     this->output_->write_state(this);
   }
+
+  // Nothing left to do until a new transition, effect or write is requested
+  if (this->transformer_ == nullptr && this->get_active_effect_() == nullptr && !this->next_write_)
+    this->disable_loop();
 }
 
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
@@ -216,6 +220,7 @@ void LightState::start_effect_(uint32_t effect_index) {
   this->active_effect_index_ = effect_index;
   auto *effect = this->get_active_effect_();
   effect->start_internal();
+  this->enable_loop();
 }
 LightEffect *LightState::get_active_effect_() {
   if (this->active_effect_index_ == 0) {
@@ -235,6 +240,7 @@ void LightState::stop_effect_() {
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
   this->transformer_ = this->output_->create_default_transition();
   this->transformer_->setup(this->current_values, target, length);
+  this->enable_loop();
 
   if (set_remote_values) {
     this->remote_values = target;
@@ -250,6 +256,7 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
 
   this->transformer_ = make_unique<LightFlashTransformer>(*this);
   this->transformer_->setup(end_colors, target, length);
+  this->enable_loop();
 
   if (set_remote_values) {
     this->remote_values = target;
@@ -265,6 +272,7 @@ void LightState::set_immediately_(const LightColorValues &target, bool set_remot
   }
   this->output_->update_state(this);
   this->next_write_ = true;
+  this->enable_loop();
 }
 
 void LightState::save_remote_values_() {
@@ -0,0 +1,30 @@
+#include "light_transformer.h"
+#include "esphome/core/application.h"
+
+namespace esphome {
+namespace light {
+
+uint32_t LightTransformer::get_progress_time_() { return App.get_loop_component_start_time(); }
+
+float LightTransformer::get_progress_() {
+  uint32_t now = LightTransformer::get_progress_time_();
+  if (now < this->start_time_)
+    return 0.0f;
+  if (now >= this->start_time_ + this->length_)
+    return 1.0f;
+
+  return clamp((now - this->start_time_) / float(this->length_), 0.0f, 1.0f);
+}
+
+uint32_t LightTransformer::get_progress_fixed_() {
+  uint32_t now = LightTransformer::get_progress_time_();
+  if (now < this->start_time_)
+    return 0;
+  if (now >= this->start_time_ + this->length_)
+    return 65536;
+
+  return static_cast<uint32_t>((static_cast<uint64_t>(now - this->start_time_) << 16) / this->length_);
+}
+
+}  // namespace light
+}  // namespace esphome
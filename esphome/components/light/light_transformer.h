@@ -39,15 +39,14 @@ class LightTransformer {
 
  protected:
   /// The progress of this transition, on a scale of 0 to 1.
-  float get_progress_() {
-    uint32_t now = esphome::millis();
-    if (now < this->start_time_)
-      return 0.0f;
-    if (now >= this->start_time_ + this->length_)
-      return 1.0f;
-
-    return clamp((now - this->start_time_) / float(this->length_), 0.0f, 1.0f);
-  }
+  float get_progress_();
+
+  /// The progress of this transition in 16.16 fixed point, on a scale of 0 to 65536.
+  uint32_t get_progress_fixed_();
+
+  /// The time progress is measured at: the start of the current loop pass, so that lights sharing a transition are
+  /// at the same point of it.
+  static uint32_t get_progress_time_();
 
   uint32_t start_time_;
   uint32_t length_;
@@ -0,0 +1,64 @@
+#include "light_output.h"
+#include "transformers.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace light {
+
+// Steps per unit of the channels on a 0 to 1 scale, too fine to see on the output after gamma correction
+static const float STEPS_PER_UNIT = 4096.0f;
+// Steps per mired of the color temperature channel
+static const float STEPS_PER_MIRED = 16.0f;
+static const uint8_t COLOR_TEMPERATURE_CHANNEL = 7;
+
+static void light_color_values_to_channels(const LightColorValues &values, float *channels) {
+  channels[0] = values.get_state();
+  channels[1] = values.get_brightness();
+  channels[2] = values.get_color_brightness();
+  channels[3] = values.get_red();
+  channels[4] = values.get_green();
+  channels[5] = values.get_blue();
+  channels[6] = values.get_white();
+  channels[COLOR_TEMPERATURE_CHANNEL] = values.get_color_temperature();
+  channels[8] = values.get_cold_white();
+  channels[9] = values.get_warm_white();
+}
+
+void LightTransitionCurve::setup(const LightColorValues &start, const LightColorValues &end) {
+  this->color_mode_ = end.get_color_mode();
+  light_color_values_to_channels(start, this->start_);
+  light_color_values_to_channels(end, this->end_);
+  for (uint8_t i = 0; i < CHANNELS; i++) {
+    float delta = this->end_[i] - this->start_[i];
+    float steps = fabsf(delta) * (i == COLOR_TEMPERATURE_CHANNEL ? STEPS_PER_MIRED : STEPS_PER_UNIT);
+    this->steps_[i] = static_cast<uint16_t>(std::min(roundf(steps), 65535.0f));
+    this->step_size_[i] = this->steps_[i] == 0 ? 0.0f : delta / this->steps_[i];
+  }
+  this->applied_ = false;
+}
+
+optional<LightColorValues> LightTransitionCurve::apply(uint32_t completion) {
+  bool changed = !this->applied_;
+  for (uint8_t i = 0; i < CHANNELS; i++) {
+    uint16_t index = (this->steps_[i] * completion + 32768) >> 16;
+    changed |= index != this->index_[i];
+    this->index_[i] = index;
+  }
+  if (!changed)
+    return {};
+  this->applied_ = true;
+
+  float values[CHANNELS];
+  for (uint8_t i = 0; i < CHANNELS; i++) {
+    // the last step lands exactly on the end value
+    values[i] = this->index_[i] == this->steps_[i] ? this->end_[i]
+                                                   : this->start_[i] + this->step_size_[i] * this->index_[i];
+  }
+  return LightColorValues(this->color_mode_, values[0], values[1], values[2], values[3], values[4], values[5],
+                          values[6], values[7], values[8], values[9]);
+}
+
+}  // namespace light
+}  // namespace esphome
@@ -9,6 +9,33 @@
 namespace esphome {
 namespace light {
 
+/** Interpolates between two LightColorValues in fixed point, quantized per channel.
+ *
+ * Each channel is divided into steps fine enough to be invisible on the output, and its position is tracked as a step
+ * index. Values are only produced when a channel moves to another step, so slow transitions don't update and write the
+ * output with values that would be the same after quantization.
+ */
+class LightTransitionCurve {
+ public:
+  void setup(const LightColorValues &start, const LightColorValues &end);
+
+  /// Return the values at the given completion in 16.16 fixed point, or nothing if no channel changed its step since
+  /// the previous call.
+  optional<LightColorValues> apply(uint32_t completion);
+
+ protected:
+  static const uint8_t CHANNELS = 10;
+
+  ColorMode color_mode_{ColorMode::UNKNOWN};
+  float start_[CHANNELS];
+  float end_[CHANNELS];
+  /// Change of the value per step.
+  float step_size_[CHANNELS];
+  uint16_t steps_[CHANNELS];
+  uint16_t index_[CHANNELS];
+  bool applied_{false};
+};
+
 class LightTransitionTransformer : public LightTransformer {
  public:
   void start() override {
@@ -28,30 +55,34 @@ class LightTransitionTransformer : public LightTransformer {
     }
 
     // When changing color mode, go through off state, as color modes are orthogonal and there can't be two active.
-    if (this->start_values_.get_color_mode() != this->target_values_.get_color_mode()) {
-      this->changing_color_mode_ = true;
-      this->intermediate_values_ = this->start_values_;
-      this->intermediate_values_.set_state(false);
+    // The first half transitions to the start values turned off, the second half from the target values turned off.
+    this->changing_color_mode_ = this->start_values_.get_color_mode() != this->target_values_.get_color_mode();
+    if (this->changing_color_mode_) {
+      LightColorValues intermediate = this->start_values_;
+      intermediate.set_state(false);
+      this->curves_[0].setup(this->start_values_, intermediate);
+      intermediate = this->target_values_;
+      intermediate.set_state(false);
+      this->curves_[1].setup(intermediate, this->end_values_);
+    } else {
+      this->curves_[0].setup(this->start_values_, this->end_values_);
     }
   }
 
   optional<LightColorValues> apply() override {
-    float p = this->get_progress_();
-
-    // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
-    if (this->changing_color_mode_ && p > 0.5f &&
-        this->intermediate_values_.get_color_mode() != this->target_values_.get_color_mode()) {
-      this->intermediate_values_ = this->target_values_;
-      this->intermediate_values_.set_state(false);
+    uint32_t p = this->get_progress_fixed_();
+
+    LightTransitionCurve *curve = &this->curves_[0];
+    if (this->changing_color_mode_) {
+      if (p > 32768) {
+        curve = &this->curves_[1];
+        p = (p - 32768) * 2;
+      } else {
+        p *= 2;
+      }
     }
 
-    LightColorValues &start = this->changing_color_mode_ && p > 0.5f ? this->intermediate_values_ : this->start_values_;
-    LightColorValues &end = this->changing_color_mode_ && p < 0.5f ? this->intermediate_values_ : this->end_values_;
-    if (this->changing_color_mode_)
-      p = p < 0.5f ? p * 2 : (p - 0.5) * 2;
-
-    float v = LightTransitionTransformer::smoothed_progress(p);
-    return LightColorValues::lerp(start, end, v);
+    return curve->apply(LightTransitionTransformer::smoothed_progress_fixed(p));
   }
 
  protected:
@@ -59,9 +90,17 @@ class LightTransitionTransformer : public LightTransformer {
   // transition from 0 to 1 on x = [0, 1]
   static float smoothed_progress(float x) { return x * x * x * (x * (x * 6.0f - 15.0f) + 10.0f); }
 
+  /// smoothed_progress() in 16.16 fixed point, on a scale of 0 to 65536.
+  static uint32_t smoothed_progress_fixed(uint32_t x) {
+    uint64_t x3 = (static_cast<uint64_t>(x) * x >> 16) * x >> 16;
+    // 6x^2 - 15x + 10 is positive on [0, 1]
+    int64_t inner = ((6 * static_cast<int64_t>(x) * x) >> 16) - 15 * static_cast<int64_t>(x) + (10 << 16);
+    return static_cast<uint32_t>((x3 * static_cast<uint64_t>(inner)) >> 16);
+  }
+
   bool changing_color_mode_{false};
   LightColorValues end_values_{};
-  LightColorValues intermediate_values_{};
+  LightTransitionCurve curves_[2];
 };
 
 class LightFlashTransformer : public LightTransformer {
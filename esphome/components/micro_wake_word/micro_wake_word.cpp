@@ -26,6 +26,14 @@ static const size_t BUFFER_LENGTH = 64;      // 0.064 seconds
 static const size_t BUFFER_SIZE = SAMPLE_RATE_HZ / 1000 * BUFFER_LENGTH;
 static const size_t INPUT_BUFFER_SIZE = 16 * SAMPLE_RATE_HZ / 1000;  // 16ms * 16kHz / 1000ms
 
+// Feature windows kept for the wake word models while the VAD model reports silence
+static const size_t FEATURE_HISTORY_WINDOWS = 32;
+static const size_t FEATURE_HISTORY_SIZE = FEATURE_HISTORY_WINDOWS * PREPROCESSOR_FEATURE_SIZE;
+// Maximum number of windows the models process per loop, which bounds the time spent catching up on the history
+static const size_t MAX_WINDOWS_PER_LOOP = 8;
+// Covers the alignment of the tensor arena's start when it is resized to the measured size
+static const size_t TENSOR_ARENA_MARGIN = 64;
+
 float MicroWakeWord::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 
 static const LogString *micro_wake_word_state_to_string(State state) {
@@ -126,6 +134,13 @@ void MicroWakeWord::loop() {
       }
       break;
     case State::STOP_MICROPHONE:
+      if (this->processed_windows_ > 0) {
+        // Processing time per second of audio is the CPU load of detection in milliseconds per second
+        ESP_LOGD(TAG, "Processed %.1f s of audio using %.1f ms per second, wake word models skipped %.0f%% of it",
+                 this->processed_windows_ * this->features_step_size_ / 1000.0f,
+                 (float) this->processing_time_us_ / (this->processed_windows_ * this->features_step_size_),
+                 100.0f * this->skipped_windows_ / this->processed_windows_);
+      }
       ESP_LOGD(TAG, "Stopping Microphone");
       this->microphone_->stop();
       this->set_state_(State::STOPPING_MICROPHONE);
@@ -243,6 +258,15 @@ bool MicroWakeWord::allocate_buffers_() {
     }
   }
 
+  if (this->feature_history_ == nullptr) {
+    ExternalRAMAllocator<int8_t> features_allocator(ExternalRAMAllocator<int8_t>::ALLOW_FAILURE);
+    this->feature_history_ = features_allocator.allocate(FEATURE_HISTORY_SIZE);
+    if (this->feature_history_ == nullptr) {
+      ESP_LOGE(TAG, "Could not allocate the feature history");
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -252,6 +276,9 @@ void MicroWakeWord::deallocate_buffers_() {
   this->input_buffer_ = nullptr;
   audio_samples_allocator.deallocate(this->preprocessor_audio_buffer_, this->new_samples_to_get_());
   this->preprocessor_audio_buffer_ = nullptr;
+  ExternalRAMAllocator<int8_t> features_allocator(ExternalRAMAllocator<int8_t>::ALLOW_FAILURE);
+  features_allocator.deallocate(this->feature_history_, FEATURE_HISTORY_SIZE);
+  this->feature_history_ = nullptr;
 }
 
 bool MicroWakeWord::load_models_() {
@@ -262,16 +289,74 @@ bool MicroWakeWord::load_models_() {
     return false;
   }
 
-  // Setup streaming models
+  if (this->tensor_arena_ != nullptr) {
+    return true;
+  }
+
+  if (this->tensor_arena_size_ > 0) {
+    if (this->load_streaming_models_(this->tensor_arena_size_))
+      return true;
+    // Measure again with the summed size on the next start
+    this->tensor_arena_size_ = 0;
+    return false;
+  }
+
+  // The models' configured sizes each include the memory for intermediate tensors, which the shared arena only
+  // needs once. Load them into an arena of the summed size once to measure what they actually use.
+  size_t arena_size = 0;
+  for (auto &model : this->wake_word_models_) {
+    arena_size += model.get_tensor_arena_size();
+  }
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  arena_size += this->vad_model_->get_tensor_arena_size();
+#endif
+  if (!this->load_streaming_models_(arena_size)) {
+    return false;
+  }
+
+  this->tensor_arena_size_ = this->tensor_allocator_->used_bytes() + TENSOR_ARENA_MARGIN;
+  if (this->tensor_arena_size_ >= arena_size) {
+    this->tensor_arena_size_ = arena_size;
+    return true;
+  }
+  ESP_LOGD(TAG, "The models share a tensor arena of %zu bytes instead of %zu bytes", this->tensor_arena_size_,
+           arena_size);
+  this->unload_streaming_models_();
+  if (!this->load_streaming_models_(this->tensor_arena_size_)) {
+    // Measure again with the summed size on the next start
+    this->tensor_arena_size_ = 0;
+    return false;
+  }
+  return true;
+}
+
+bool MicroWakeWord::load_streaming_models_(size_t arena_size) {
+  ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->tensor_arena_ = arena_allocator.allocate(arena_size);
+  if (this->tensor_arena_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate the shared tensor arena.");
+    return false;
+  }
+  this->allocated_tensor_arena_size_ = arena_size;
+
+  this->tensor_allocator_ = tflite::MicroAllocator::Create(this->tensor_arena_, arena_size);
+  if (this->tensor_allocator_ == nullptr) {
+    ESP_LOGE(TAG, "Could not create the shared tensor arena's allocator.");
+    this->unload_streaming_models_();
+    return false;
+  }
+
   for (auto &model : this->wake_word_models_) {
-    if (!model.load_model(this->streaming_op_resolver_)) {
+    if (!model.load_model(this->streaming_op_resolver_, this->tensor_allocator_)) {
       ESP_LOGE(TAG, "Failed to initialize a wake word model.");
+      this->unload_streaming_models_();
       return false;
     }
   }
 #ifdef USE_MICRO_WAKE_WORD_VAD
-  if (!this->vad_model_->load_model(this->streaming_op_resolver_)) {
+  if (!this->vad_model_->load_model(this->streaming_op_resolver_, this->tensor_allocator_)) {
     ESP_LOGE(TAG, "Failed to initialize VAD model.");
+    this->unload_streaming_models_();
     return false;
   }
 #endif
@@ -282,31 +367,82 @@ bool MicroWakeWord::load_models_() {
 void MicroWakeWord::unload_models_() {
   FrontendFreeStateContents(&this->frontend_state_);
 
+  this->unload_streaming_models_();
+}
+
+void MicroWakeWord::unload_streaming_models_() {
+  // Every interpreter using the shared arena has to be destroyed before it is freed
   for (auto &model : this->wake_word_models_) {
     model.unload_model();
   }
 #ifdef USE_MICRO_WAKE_WORD_VAD
   this->vad_model_->unload_model();
 #endif
+
+  ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  arena_allocator.deallocate(this->tensor_arena_, this->allocated_tensor_arena_size_);
+  this->tensor_arena_ = nullptr;
+  this->tensor_allocator_ = nullptr;
 }
 
 void MicroWakeWord::update_model_probabilities_() {
-  int8_t audio_features[PREPROCESSOR_FEATURE_SIZE];
+  uint32_t start_time = micros();
+
+  size_t new_windows = 0;
+  while (new_windows < MAX_WINDOWS_PER_LOOP &&
+         this->generate_features_for_window_(&this->feature_history_[this->history_end_ * PREPROCESSOR_FEATURE_SIZE])) {
+    this->history_end_ = (this->history_end_ + 1) % FEATURE_HISTORY_WINDOWS;
+    // When the history is full, the wake word models lose its oldest window
+    this->pending_windows_ = std::min(this->pending_windows_ + 1, FEATURE_HISTORY_WINDOWS);
+    ++new_windows;
+  }
 
-  if (!this->generate_features_for_window_(audio_features)) {
+  if (new_windows == 0) {
     return;
   }
 
   // Increase the counter since the last positive detection
-  this->ignore_windows_ = std::min(this->ignore_windows_ + 1, 0);
+  this->ignore_windows_ = std::min<int32_t>(this->ignore_windows_ + (int32_t) new_windows, 0);
+  this->processed_windows_ += new_windows;
 
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  this->feed_history_(*this->vad_model_, new_windows, new_windows);
+  if (this->vad_model_->determine_detected()) {
+    this->vad_hangover_ = FEATURE_HISTORY_WINDOWS;
+  } else if (this->vad_hangover_ > new_windows) {
+    this->vad_hangover_ -= new_windows;
+  } else {
+    if (this->vad_hangover_ > 0) {
+      // Stale probabilities must not count towards a detection once the models resume
+      for (auto &model : this->wake_word_models_) {
+        model.reset_probabilities();
+      }
+    }
+    this->vad_hangover_ = 0;
+    this->skipped_windows_ += new_windows;
+    this->processing_time_us_ += micros() - start_time;
+    return;
+  }
+#endif
+
+  size_t windows = std::min(this->pending_windows_, MAX_WINDOWS_PER_LOOP);
   for (auto &model : this->wake_word_models_) {
     // Perform inference
-    model.perform_streaming_inference(audio_features);
+    this->feed_history_(model, this->pending_windows_, windows);
+  }
+  this->pending_windows_ -= windows;
+
+  this->processing_time_us_ += micros() - start_time;
+}
+
+void MicroWakeWord::feed_history_(StreamingModel &model, size_t age, size_t windows) {
+  size_t first = (this->history_end_ + FEATURE_HISTORY_WINDOWS - age) % FEATURE_HISTORY_WINDOWS;
+  while (windows > 0) {
+    size_t count = std::min(windows, FEATURE_HISTORY_WINDOWS - first);
+    model.perform_streaming_inference(&this->feature_history_[first * PREPROCESSOR_FEATURE_SIZE], count);
+    windows -= count;
+    first = 0;
   }
-#ifdef USE_MICRO_WAKE_WORD_VAD
-  this->vad_model_->perform_streaming_inference(audio_features);
-#endif
 }
 
 bool MicroWakeWord::detect_wake_words_() {
@@ -399,6 +535,14 @@ void MicroWakeWord::reset_states_() {
   ESP_LOGD(TAG, "Resetting buffers and probabilities");
   this->ring_buffer_->reset();
   this->ignore_windows_ = -MIN_SLICES_BEFORE_DETECTION;
+  this->history_end_ = 0;
+  this->pending_windows_ = 0;
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  this->vad_hangover_ = 0;
+#endif
+  this->processed_windows_ = 0;
+  this->skipped_windows_ = 0;
+  this->processing_time_us_ = 0;
   for (auto &model : this->wake_word_models_) {
     model.reset_probabilities();
   }
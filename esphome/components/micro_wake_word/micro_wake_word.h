@@ -74,6 +74,30 @@ class MicroWakeWord : public Component {
 
   tflite::MicroMutableOpResolver<20> streaming_op_resolver_;
 
+  // The models run one after the other, so they share a tensor arena. Its size is measured at the first load, before
+  // that the sum of the models' configured sizes is allocated.
+  uint8_t *tensor_arena_{nullptr};
+  size_t tensor_arena_size_{0};
+  size_t allocated_tensor_arena_size_{0};
+  // Placed in the tensor arena
+  tflite::MicroAllocator *tensor_allocator_{nullptr};
+
+  // Ring of recent feature windows. The wake word models consume them in batches and skip them while the VAD model
+  // reports silence, so that the start of speech can be replayed once it detects voice.
+  int8_t *feature_history_{nullptr};
+  size_t history_end_{0};
+  // Windows of the history that the wake word models have not processed yet
+  size_t pending_windows_{0};
+#ifdef USE_MICRO_WAKE_WORD_VAD
+  // Windows the wake word models keep running for after the VAD model last detected voice
+  size_t vad_hangover_{0};
+#endif
+
+  // Processing statistics, logged when detection stops
+  uint32_t processed_windows_{0};
+  uint32_t skipped_windows_{0};
+  uint64_t processing_time_us_{0};
+
   // Audio frontend handles generating spectrogram features
   struct FrontendConfig frontend_config_;
   struct FrontendState frontend_state_;
@@ -122,13 +146,26 @@ class MicroWakeWord : public Component {
   /// generation frontend.
   void unload_models_();
 
+  /// @brief Allocates the shared tensor arena and loads every streaming model into it
+  /// @return True if successful, false otherwise
+  bool load_streaming_models_(size_t arena_size);
+
+  /// @brief Deletes each streaming model's TFLite interpreter and frees the shared tensor arena
+  void unload_streaming_models_();
+
   /** Performs inference with each configured model
    *
-   * If enough audio samples are available, it will generate one slice of new features.
-   * It then loops through and performs inference with each of the loaded models.
+   * Generates features for every window of audio available in the ring buffer and adds them to the feature history.
+   * The VAD model processes the new windows first. While it detects voice, the wake word models process the windows
+   * in the history they haven't seen yet, otherwise they are skipped.
    */
   void update_model_probabilities_();
 
+  /// @brief Feeds windows from the feature history to a model, in one call unless they wrap around the ring
+  /// @param age Number of windows generated since the first window to feed, counting itself
+  /// @param windows Number of windows to feed
+  void feed_history_(StreamingModel &model, size_t age, size_t windows);
+
   /** Checks every model's recent probabilities to determine if the wake word has been predicted
    *
    * Verifies the models have processed enough new samples for accurate predictions.
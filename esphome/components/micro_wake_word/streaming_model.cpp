@@ -23,17 +23,9 @@ void VADModel::log_model_config() {
   ESP_LOGCONFIG(TAG, "      Sliding window size: %d", this->sliding_window_size_);
 }
 
-bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver) {
+bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver, tflite::MicroAllocator *allocator) {
   ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
 
-  if (this->tensor_arena_ == nullptr) {
-    this->tensor_arena_ = arena_allocator.allocate(this->tensor_arena_size_);
-    if (this->tensor_arena_ == nullptr) {
-      ESP_LOGE(TAG, "Could not allocate the streaming model's tensor arena.");
-      return false;
-    }
-  }
-
   if (this->var_arena_ == nullptr) {
     this->var_arena_ = arena_allocator.allocate(STREAMING_MODEL_VARIABLE_ARENA_SIZE);
     if (this->var_arena_ == nullptr) {
@@ -51,8 +43,8 @@ bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver)
   }
 
   if (this->interpreter_ == nullptr) {
-    this->interpreter_ = make_unique<tflite::MicroInterpreter>(
-        tflite::GetModel(this->model_start_), op_resolver, this->tensor_arena_, this->tensor_arena_size_, this->mrv_);
+    this->interpreter_ =
+        make_unique<tflite::MicroInterpreter>(tflite::GetModel(this->model_start_), op_resolver, allocator, this->mrv_);
     if (this->interpreter_->AllocateTensors() != kTfLiteOk) {
       ESP_LOGE(TAG, "Failed to allocate tensors for the streaming model");
       return false;
@@ -82,6 +74,10 @@ bool StreamingModel::load_model(tflite::MicroMutableOpResolver<20> &op_resolver)
       ESP_LOGE(TAG, "Streaming model tensor output is not uint8.");
       return false;
     }
+
+    this->stride_ = input->dims->data[1];
+    this->stride_features_.resize(this->stride_ * PREPROCESSOR_FEATURE_SIZE);
+    this->current_stride_step_ = 0;
   }
 
   return true;
@@ -92,43 +88,45 @@ void StreamingModel::unload_model() {
 
   ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
 
-  arena_allocator.deallocate(this->tensor_arena_, this->tensor_arena_size_);
-  this->tensor_arena_ = nullptr;
   arena_allocator.deallocate(this->var_arena_, STREAMING_MODEL_VARIABLE_ARENA_SIZE);
   this->var_arena_ = nullptr;
 }
 
-bool StreamingModel::perform_streaming_inference(const int8_t features[PREPROCESSOR_FEATURE_SIZE]) {
-  if (this->interpreter_ != nullptr) {
-    TfLiteTensor *input = this->interpreter_->input(0);
+bool StreamingModel::perform_streaming_inference(const int8_t *features, size_t windows) {
+  if (this->interpreter_ == nullptr) {
+    ESP_LOGE(TAG, "Streaming interpreter is not initialized.");
+    return false;
+  }
 
-    std::memmove(
-        (int8_t *) (tflite::GetTensorData<int8_t>(input)) + PREPROCESSOR_FEATURE_SIZE * this->current_stride_step_,
-        features, PREPROCESSOR_FEATURE_SIZE);
-    ++this->current_stride_step_;
+  while (windows > 0) {
+    size_t count = std::min<size_t>(windows, this->stride_ - this->current_stride_step_);
+    std::memcpy(&this->stride_features_[PREPROCESSOR_FEATURE_SIZE * this->current_stride_step_], features,
+                count * PREPROCESSOR_FEATURE_SIZE);
+    this->current_stride_step_ += count;
+    features += count * PREPROCESSOR_FEATURE_SIZE;
+    windows -= count;
 
-    uint8_t stride = this->interpreter_->input(0)->dims->data[1];
+    if (this->current_stride_step_ < this->stride_)
+      break;
+    this->current_stride_step_ = 0;
 
-    if (this->current_stride_step_ >= stride) {
-      this->current_stride_step_ = 0;
+    TfLiteTensor *input = this->interpreter_->input(0);
+    std::memcpy(tflite::GetTensorData<int8_t>(input), this->stride_features_.data(), this->stride_features_.size());
 
-      TfLiteStatus invoke_status = this->interpreter_->Invoke();
-      if (invoke_status != kTfLiteOk) {
-        ESP_LOGW(TAG, "Streaming interpreter invoke failed");
-        return false;
-      }
+    TfLiteStatus invoke_status = this->interpreter_->Invoke();
+    if (invoke_status != kTfLiteOk) {
+      ESP_LOGW(TAG, "Streaming interpreter invoke failed");
+      return false;
+    }
 
-      TfLiteTensor *output = this->interpreter_->output(0);
+    TfLiteTensor *output = this->interpreter_->output(0);
 
-      ++this->last_n_index_;
-      if (this->last_n_index_ == this->sliding_window_size_)
-        this->last_n_index_ = 0;
-      this->recent_streaming_probabilities_[this->last_n_index_] = output->data.uint8[0];  // probability;
-    }
-    return true;
+    ++this->last_n_index_;
+    if (this->last_n_index_ == this->sliding_window_size_)
+      this->last_n_index_ = 0;
+    this->recent_streaming_probabilities_[this->last_n_index_] = output->data.uint8[0];  // probability;
   }
-  ESP_LOGE(TAG, "Streaming interpreter is not initialized.");
-  return false;
+  return true;
 }
 
 void StreamingModel::reset_probabilities() {
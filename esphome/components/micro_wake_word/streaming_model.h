@@ -5,6 +5,7 @@
 #include "preprocessor_settings.h"
 
 #include <tensorflow/lite/core/c/common.h>
+#include <tensorflow/lite/micro/micro_allocator.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 
@@ -18,21 +19,35 @@ class StreamingModel {
   virtual void log_model_config() = 0;
   virtual bool determine_detected() = 0;
 
-  bool perform_streaming_inference(const int8_t features[PREPROCESSOR_FEATURE_SIZE]);
+  /// @brief Feeds feature windows to the model, invoking it each time a full stride of windows has been collected
+  /// @param features Consecutive windows of PREPROCESSOR_FEATURE_SIZE features
+  /// @param windows Number of windows
+  /// @return True if successful, false otherwise
+  bool perform_streaming_inference(const int8_t *features, size_t windows = 1);
 
   /// @brief Sets all recent_streaming_probabilities to 0
   void reset_probabilities();
 
-  /// @brief Allocates tensor and variable arenas and sets up the model interpreter
+  /// @brief Allocates the variable arena and sets up the model interpreter
   /// @param op_resolver MicroMutableOpResolver object that must exist until the model is unloaded
+  /// @param allocator Allocator of the tensor arena, which may be shared with other models that are not invoked at the
+  /// same time. It must exist until the model is unloaded.
   /// @return True if successful, false otherwise
-  bool load_model(tflite::MicroMutableOpResolver<20> &op_resolver);
+  bool load_model(tflite::MicroMutableOpResolver<20> &op_resolver, tflite::MicroAllocator *allocator);
 
-  /// @brief Destroys the TFLite interpreter and frees the tensor and variable arenas' memory
+  /// @brief Destroys the TFLite interpreter and frees the variable arena's memory
   void unload_model();
 
+  /// @brief Size of the tensor arena the model needs on its own, as configured
+  size_t get_tensor_arena_size() const { return this->tensor_arena_size_; }
+
  protected:
   uint8_t current_stride_step_{0};
+  // Number of feature windows the model takes per invocation
+  uint8_t stride_{1};
+  // Collects the windows of a stride. The input tensor can't hold them between invocations, as the arena holding it is
+  // shared with the other models.
+  std::vector<int8_t> stride_features_;
 
   float probability_cutoff_;
   size_t sliding_window_size_;
@@ -41,7 +56,6 @@ class StreamingModel {
   std::vector<uint8_t> recent_streaming_probabilities_;
 
   const uint8_t *model_start_;
-  uint8_t *tensor_arena_{nullptr};
   uint8_t *var_arena_{nullptr};
   std::unique_ptr<tflite::MicroInterpreter> interpreter_;
   tflite::MicroResourceVariables *mrv_{nullptr};
@@ -2,29 +2,39 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace modbus {
 
 static const char *const TAG = "modbus";
 
+/// Maximum size of a Modbus RTU frame.
+static const size_t MAX_FRAME_SIZE = 256;
+
 void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+  this->rx_buffer_.reserve(MAX_FRAME_SIZE);
 }
 void Modbus::loop() {
   const uint32_t now = millis();
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
-    } else {
-      size_t at = this->rx_buffer_.size();
-      if (at > 0) {
-        ESP_LOGV(TAG, "Clearing buffer of %d bytes - parse failed", at);
-        this->rx_buffer_.clear();
+  uint8_t buf[64];
+  size_t to_read;
+  while ((to_read = std::min<size_t>(this->available(), sizeof(buf))) > 0) {
+    if (!this->read_array(buf, to_read))
+      break;
+    for (size_t i = 0; i < to_read; i++) {
+      if (this->parse_modbus_byte_(buf[i])) {
+        this->last_modbus_byte_ = now;
+      } else {
+        size_t at = this->rx_buffer_.size();
+        if (at > 0) {
+          ESP_LOGV(TAG, "Clearing buffer of %zu bytes - parse failed", at);
+          this->rx_buffer_.clear();
+        }
       }
     }
   }
@@ -32,7 +42,7 @@ void Modbus::loop() {
   if (now - this->last_modbus_byte_ > 50) {
     size_t at = this->rx_buffer_.size();
     if (at > 0) {
-      ESP_LOGV(TAG, "Clearing buffer of %d bytes - timeout", at);
+      ESP_LOGV(TAG, "Clearing buffer of %zu bytes - timeout", at);
       this->rx_buffer_.clear();
     }
 
@@ -47,86 +57,89 @@ void Modbus::loop() {
 
 bool Modbus::parse_modbus_byte_(uint8_t byte) {
   size_t at = this->rx_buffer_.size();
+  if (at == 0)
+    this->rx_crc_ = 0xFFFF;
   this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
+  // The CRC is updated as bytes come in, including the CRC of the frame itself which makes it 0 for a valid frame.
+  this->rx_crc_ = crc16(&byte, 1, this->rx_crc_);
   ESP_LOGVV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
   // Byte 0: modbus address (match all)
   if (at == 0)
     return true;
-  uint8_t address = raw[0];
-  uint8_t function_code = raw[1];
-  // Byte 2: Size (with modbus rtu function code 4/3)
-  // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
-    return true;
-
-  uint8_t data_len = raw[2];
-  uint8_t data_offset = 3;
 
+  const uint8_t function_code = this->rx_buffer_[1];
   // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
-  if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
+  const bool user_defined =
+      ((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110));
+
+  if (at == 1) {
+    // Byte 1: function code, which determines the layout of the rest of the frame
+    // See also https://en.wikipedia.org/wiki/Modbus
+    this->rx_frame_length_ = 0;
+    if (user_defined) {
+      this->rx_data_offset_ = 1;
+    } else if ((function_code & 0x80) == 0x80) {
+      // Error ( msb indicates error )
+      // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code,
+      // Byte[3-4] crc
+      this->rx_data_offset_ = 2;
+      this->rx_frame_length_ = 2 + 1 + 2;
+    } else if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10 ||
+               (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4))) {
+      // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands,
+      // data starts at 2 and length is 4 for read registers commands
+      this->rx_data_offset_ = 2;
+      this->rx_frame_length_ = 2 + 4 + 2;
+    } else {
+      // Byte 2: Size (with modbus rtu function code 4/3)
+      this->rx_data_offset_ = 3;
+    }
+    return true;
+  }
+  if (at == 2) {
+    if (this->rx_data_offset_ == 3)
+      this->rx_frame_length_ = 3 + byte + 2;
+    return true;
+  }
+
+  if (user_defined) {
     // Handle user-defined function, since we don't know how big this ought to be,
     // ideally we should delegate the entire length detection to whatever handler is
     // installed, but wait, there is the CRC, and if we get a hit there is a good
     // chance that this is a complete message ... admittedly there is a small chance is
     // isn't but that is quite small given the purpose of the CRC in the first place
-
-    // Fewer than 2 bytes can't calc CRC
-    if (at < 2)
-      return true;
-
-    data_len = at - 2;
-    data_offset = 1;
-
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-
-    if (computed_crc != remote_crc)
+    if (this->rx_crc_ != 0)
       return true;
 
     ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
+    this->handle_frame_(1, at - 2);
+    return true;
+  }
 
-  } else {
-    // data starts at 2 and length is 4 for read registers commands
-    if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
-      data_offset = 2;
-      data_len = 4;
-    }
-
-    // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands
-    if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
-      data_offset = 2;
-      data_len = 4;
-    }
-
-    // Error ( msb indicates error )
-    // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code, Byte[3-4] crc
-    if ((function_code & 0x80) == 0x80) {
-      data_offset = 2;
-      data_len = 1;
-    }
-
-    // Byte data_offset..data_offset+data_len-1: Data
-    if (at < data_offset + data_len)
-      return true;
-
-    // Byte 3+data_len: CRC_LO (over all bytes)
-    if (at == data_offset + data_len)
-      return true;
+  // Byte data_offset..data_offset+data_len-1: Data, followed by CRC_LO and CRC_HI (over all bytes)
+  if (at + 1 < this->rx_frame_length_)
+    return true;
 
-    // Byte data_offset+len+1: CRC_HI (over all bytes)
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-    if (computed_crc != remote_crc) {
-      if (this->disable_crc_) {
-        ESP_LOGD(TAG, "Modbus CRC Check failed, but ignored! %02X!=%02X", computed_crc, remote_crc);
-      } else {
-        ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
-        return false;
-      }
+  if (this->rx_crc_ != 0) {
+    // The expected and received CRC are only needed for the log message
+    if (this->disable_crc_) {
+      ESP_LOGD(TAG, "Modbus CRC Check failed, but ignored! %02X!=%02X", crc16(this->rx_buffer_.data(), at - 1),
+               uint16_t(this->rx_buffer_[at - 1]) | (uint16_t(this->rx_buffer_[at]) << 8));
+    } else {
+      ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", crc16(this->rx_buffer_.data(), at - 1),
+               uint16_t(this->rx_buffer_[at - 1]) | (uint16_t(this->rx_buffer_[at]) << 8));
+      return false;
     }
   }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
+  this->handle_frame_(this->rx_data_offset_, at - 1 - this->rx_data_offset_);
+  return true;
+}
+
+void Modbus::handle_frame_(size_t data_offset, size_t data_len) {
+  const uint8_t *raw = this->rx_buffer_.data();
+  const uint8_t *data = raw + data_offset;
+  uint8_t address = raw[0];
+  uint8_t function_code = raw[1];
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
@@ -143,7 +156,7 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
         device->on_modbus_read_registers(function_code, uint16_t(data[1]) | (uint16_t(data[0]) << 8),
                                          uint16_t(data[3]) | (uint16_t(data[2]) << 8));
       } else {
-        device->on_modbus_data(data);
+        device->on_modbus_frame(data, data_len);
       }
       found = true;
     }
@@ -155,9 +168,8 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
   }
 
   // reset buffer
-  ESP_LOGV(TAG, "Clearing buffer of %d bytes - parse succeeded", at);
+  ESP_LOGV(TAG, "Clearing buffer of %zu bytes - parse succeeded", this->rx_buffer_.size() - 1);
   this->rx_buffer_.clear();
-  return true;
 }
 
 void Modbus::dump_config() {
@@ -37,6 +37,7 @@ class Modbus : public uart::UARTDevice, public Component {
   uint8_t waiting_for_response{0};
   void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
   void set_disable_crc(bool disable_crc) { disable_crc_ = disable_crc; }
+  uint32_t get_baud_rate() const { return this->parent_->get_baud_rate(); }
 
   ModbusRole role;
 
@@ -44,9 +45,17 @@ class Modbus : public uart::UARTDevice, public Component {
   GPIOPin *flow_control_pin_{nullptr};
 
   bool parse_modbus_byte_(uint8_t byte);
+  /// Hand the complete frame in rx_buffer_ to the devices.
+  void handle_frame_(size_t data_offset, size_t data_len);
   uint16_t send_wait_time_{250};
   bool disable_crc_;
   std::vector<uint8_t> rx_buffer_;
+  /// CRC of the bytes in rx_buffer_, which becomes 0 once a frame and its valid CRC are complete.
+  uint16_t rx_crc_{0xFFFF};
+  /// Length of the frame in rx_buffer_ including the CRC, 0 while it isn't known yet.
+  size_t rx_frame_length_{0};
+  /// Offset of the data in the frame in rx_buffer_.
+  uint8_t rx_data_offset_{0};
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
@@ -56,7 +65,13 @@ class ModbusDevice {
  public:
   void set_parent(Modbus *parent) { parent_ = parent; }
   void set_address(uint8_t address) { address_ = address; }
+  /// Called for every received frame with a copy of its data. Devices implement this, or on_modbus_frame() to avoid the
+  /// copy.
   virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
+  /// Called for every received frame, data points into the receive buffer and is only valid during the call.
+  virtual void on_modbus_frame(const uint8_t *data, size_t len) {
+    this->on_modbus_data(std::vector<uint8_t>(data, data + len));
+  }
   virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
   virtual void on_modbus_read_registers(uint8_t function_code, uint16_t start_address, uint16_t number_of_registers){};
   void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
@@ -2,11 +2,20 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
+/// Largest number of registers a single read command may request.
+static const uint16_t MAX_READ_REGISTERS = 125;
+/// Bytes of a read request plus the bytes a response adds to its data.
+static const size_t FRAME_OVERHEAD_BYTES = 8 + 5;
+/// Upper limit of the delay added to command_throttle while the device misses responses.
+static const uint16_t MAX_THROTTLE_BACKOFF = 500;
+
 void ModbusController::setup() { this->create_register_ranges_(); }
 
 /*
@@ -18,11 +27,16 @@ void ModbusController::setup() { this->create_register_ranges_(); }
 bool ModbusController::send_next_command_() {
   uint32_t last_send = millis() - this->last_command_timestamp_;
 
-  if ((last_send > this->command_throttle_) && !waiting_for_response() && !this->command_queue_.empty()) {
+  if ((last_send > this->command_throttle_ + this->throttle_backoff_) && !waiting_for_response() &&
+      !this->command_queue_.empty()) {
     auto &command = this->command_queue_.front();
 
     // remove from queue if command was sent too often
     if (!command->should_retry(this->max_cmd_retries_)) {
+      if (this->is_merged_read_(*command)) {
+        ESP_LOGW(TAG, "Modbus device=%d doesn't answer reads across register gaps, disabling them", this->address_);
+        this->merge_register_gaps_ = false;
+      }
       if (!this->module_offline_) {
         ESP_LOGW(TAG, "Modbus device=%d set offline", this->address_);
 
@@ -42,6 +56,10 @@ bool ModbusController::send_next_command_() {
     } else {
       ESP_LOGV(TAG, "Sending next modbus command to device %d register 0x%02X count %d", this->address_,
                command->register_address, command->register_count);
+      if (command->get_send_count() > 0) {
+        // the last attempt timed out, give the device more time between commands
+        this->throttle_backoff_ = std::min<uint32_t>(this->throttle_backoff_ * 2 + 10, MAX_THROTTLE_BACKOFF);
+      }
       command->send();
 
       this->last_command_timestamp_ = millis();
@@ -58,7 +76,7 @@ bool ModbusController::send_next_command_() {
 }
 
 // Queue incoming response
-void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
+void ModbusController::on_modbus_frame(const uint8_t *data, size_t len) {
   auto &current_command = this->command_queue_.front();
   if (current_command != nullptr) {
     if (this->module_offline_) {
@@ -75,8 +93,16 @@ void ModbusController::on_modbus_data(const std::vector<uint8_t> &data) {
       this->online_callback_.call((int) current_command->function_code, current_command->register_address);
     }
 
+    // Track how long the device takes to answer, beyond the time needed to transfer the frames
+    uint32_t elapsed = millis() - this->last_command_timestamp_;
+    uint32_t transfer = this->transfer_time_(FRAME_OVERHEAD_BYTES + len);
+    uint32_t turnaround = elapsed > transfer ? elapsed - transfer : 0;
+    this->turnaround_ = this->turnaround_ == 0 ? turnaround : (this->turnaround_ * 7 + turnaround) / 8;
+    // Back off from the added throttle delay as long as the device keeps answering
+    this->throttle_backoff_ -= (this->throttle_backoff_ + 3) / 4;
+
     // Move the commandItem to the response queue
-    current_command->payload = data;
+    current_command->payload.assign(data, data + len);
     this->incoming_queue_.push(std::move(current_command));
     ESP_LOGV(TAG, "Modbus response queued");
     this->command_queue_.pop_front();
@@ -101,6 +127,10 @@ void ModbusController::on_modbus_error(uint8_t function_code, uint8_t exception_
              "payload size=%zu",
              function_code, current_command->register_address, current_command->register_count,
              current_command->payload.size());
+    if (this->is_merged_read_(*current_command)) {
+      ESP_LOGW(TAG, "Modbus device=%d rejects reads across register gaps, disabling them", this->address_);
+      this->merge_register_gaps_ = false;
+    }
     this->command_queue_.pop_front();
   }
 }
@@ -151,27 +181,29 @@ void ModbusController::on_modbus_read_registers(uint8_t function_code, uint16_t
   this->send(function_code, start_address, number_of_registers, response.size(), response.data());
 }
 
-SensorSet ModbusController::find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const {
-  auto reg_it = find_if(begin(register_ranges_), end(register_ranges_), [=](RegisterRange const &r) {
-    return (r.start_address == start_address && r.register_type == register_type);
-  });
+RegisterRange *ModbusController::find_range_(ModbusRegisterType register_type, uint16_t start_address) {
+  auto reg_it = std::lower_bound(this->register_ranges_.begin(), this->register_ranges_.end(),
+                                 std::make_pair(register_type, start_address),
+                                 [](const RegisterRange &r, const std::pair<ModbusRegisterType, uint16_t> &key) {
+                                   return std::make_pair(r.register_type, r.start_address) < key;
+                                 });
 
-  if (reg_it == register_ranges_.end()) {
+  if (reg_it == this->register_ranges_.end() || reg_it->register_type != register_type ||
+      reg_it->start_address != start_address) {
     ESP_LOGE(TAG, "No matching range for sensor found - start_address : 0x%X", start_address);
-  } else {
-    return reg_it->sensors;
+    return nullptr;
   }
-
-  // not found
-  return {};
+  return &*reg_it;
 }
 void ModbusController::on_register_data(ModbusRegisterType register_type, uint16_t start_address,
                                         const std::vector<uint8_t> &data) {
   ESP_LOGV(TAG, "data for register address : 0x%X : ", start_address);
 
   // loop through all sensors with the same start address
-  auto sensors = find_sensors_(register_type, start_address);
-  for (auto *sensor : sensors) {
+  RegisterRange *range = this->find_range_(register_type, start_address);
+  if (range == nullptr)
+    return;
+  for (auto *sensor : range->sensors) {
     sensor->parse_and_publish(data);
   }
 }
@@ -195,32 +227,102 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
-  ESP_LOGV(TAG, "Range : %X Size: %x (%d) skip: %d", r.start_address, r.register_count, (int) r.register_type,
-           r.skip_updates_counter);
-  if (r.skip_updates_counter == 0) {
-    // if a custom command is used the user supplied custom_data is only available in the SensorItem.
-    if (r.register_type == ModbusRegisterType::CUSTOM) {
-      auto sensors = this->find_sensors_(r.register_type, r.start_address);
-      if (!sensors.empty()) {
-        auto sensor = sensors.cbegin();
-        auto command_item = ModbusCommandItem::create_custom_command(
-            this, (*sensor)->custom_data,
-            [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
-              this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
-            });
-        command_item.register_address = (*sensor)->start_address;
-        command_item.register_count = (*sensor)->register_count;
-        command_item.function_code = ModbusFunctionCode::CUSTOM;
-        queue_command(command_item);
-      }
-    } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+  // if a custom command is used the user supplied custom_data is only available in the SensorItem.
+  if (r.register_type == ModbusRegisterType::CUSTOM) {
+    if (!r.sensors.empty()) {
+      SensorItem *sensor = r.sensors.front();
+      auto command_item = ModbusCommandItem::create_custom_command(
+          this, sensor->custom_data,
+          [this](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+            this->on_register_data(ModbusRegisterType::CUSTOM, start_address, data);
+          });
+      command_item.register_address = sensor->start_address;
+      command_item.register_count = sensor->register_count;
+      command_item.function_code = ModbusFunctionCode::CUSTOM;
+      queue_command(command_item);
     }
-    r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
-    r.skip_updates_counter--;
+    queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+  }
+}
+
+void ModbusController::update_ranges_(const std::vector<RegisterRange *> &ranges) {
+  if (ranges.size() == 1) {
+    this->update_range_(*ranges.front());
+    return;
+  }
+  const RegisterRange *first = ranges.front();
+  const RegisterRange *last = ranges.back();
+  std::vector<uint16_t> range_starts;
+  range_starts.reserve(ranges.size());
+  for (auto *r : ranges)
+    range_starts.push_back(r->start_address);
+  uint16_t register_count = last->start_address + last->register_count - first->start_address;
+  ESP_LOGV(TAG, "Reading %zu ranges 0x%X-0x%X in one command", ranges.size(), first->start_address,
+           first->start_address + register_count - 1);
+  queue_command(ModbusCommandItem::create_read_command(
+      this, first->register_type, first->start_address, register_count,
+      [this, range_starts](ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data) {
+        this->on_merged_register_data_(register_type, start_address, range_starts, data);
+      }));
+}
+
+void ModbusController::on_merged_register_data_(ModbusRegisterType register_type, uint16_t start_address,
+                                                const std::vector<uint16_t> &range_starts,
+                                                const std::vector<uint8_t> &data) {
+  std::vector<uint8_t> range_data;
+  for (uint16_t range_start : range_starts) {
+    RegisterRange *range = this->find_range_(register_type, range_start);
+    if (range == nullptr)
+      continue;
+    size_t offset = (range_start - start_address) * 2;
+    if (offset >= data.size())
+      break;
+    size_t end = std::min<size_t>(offset + range->register_count * 2, data.size());
+    range_data.assign(data.begin() + offset, data.begin() + end);
+    for (auto *sensor : range->sensors) {
+      sensor->parse_and_publish(range_data);
+    }
   }
 }
+
+bool ModbusController::is_mergeable_(const RegisterRange &r) const {
+  if (r.register_type != ModbusRegisterType::HOLDING && r.register_type != ModbusRegisterType::READ)
+    return false;
+  // the user split the registers into a range of its own on purpose
+  if (r.force_new_range)
+    return false;
+  // sensors with a custom response size don't map to registers in the response
+  return std::none_of(r.sensors.begin(), r.sensors.end(), [](const SensorItem *s) { return s->response_bytes > 0; });
+}
+
+bool ModbusController::is_merged_read_(const ModbusCommandItem &command) const {
+  if (command.function_code != ModbusFunctionCode::READ_HOLDING_REGISTERS &&
+      command.function_code != ModbusFunctionCode::READ_INPUT_REGISTERS)
+    return false;
+  return std::none_of(this->register_ranges_.begin(), this->register_ranges_.end(), [&command](const RegisterRange &r) {
+    return r.register_type == command.register_type && r.start_address == command.register_address &&
+           r.register_count == command.register_count;
+  });
+}
+
+uint32_t ModbusController::transfer_time_(size_t bytes) const {
+  uint32_t baud_rate = this->parent_->get_baud_rate();
+  if (baud_rate == 0)
+    return 0;
+  // 10 bits per byte with start and stop bit
+  return (bytes * 10000 + baud_rate - 1) / baud_rate;
+}
+
+uint16_t ModbusController::max_register_gap_() const {
+  // An extra command costs the transfer of its frame overhead and the time the device needs to answer,
+  // or the command throttle if that is longer. Reading an unused register costs the transfer of two bytes.
+  uint32_t command_cost = std::max<uint32_t>(this->turnaround_ + this->transfer_time_(FRAME_OVERHEAD_BYTES),
+                                             this->command_throttle_ + this->throttle_backoff_);
+  uint32_t gap = command_cost * this->parent_->get_baud_rate() / 20000;
+  return std::min<uint32_t>(gap, MAX_READ_REGISTERS);
+}
+
 //
 // Queue the modbus requests to be send.
 // Once we get a response to the command it is removed from the queue and the next command is send
@@ -232,10 +334,34 @@ void ModbusController::update() {
     ESP_LOGV(TAG, "Updating modbus component");
   }
 
+  // Ranges due in this update that are close enough to each other are read by a single command
+  uint16_t max_gap = this->merge_register_gaps_ ? this->max_register_gap_() : 0;
+  std::vector<RegisterRange *> ranges;
   for (auto &r : this->register_ranges_) {
-    ESP_LOGVV(TAG, "Updating range 0x%X", r.start_address);
-    update_range_(r);
+    ESP_LOGV(TAG, "Range : %X Size: %x (%d) skip: %d", r.start_address, r.register_count, (int) r.register_type,
+             r.skip_updates_counter);
+    if (r.skip_updates_counter != 0) {
+      r.skip_updates_counter--;
+      continue;
+    }
+    r.skip_updates_counter = r.skip_updates;  // reset counter to config value
+
+    if (!ranges.empty()) {
+      const RegisterRange *first = ranges.front();
+      uint32_t end = ranges.back()->start_address + ranges.back()->register_count;
+      bool merge = this->merge_register_gaps_ && r.register_type == first->register_type && r.start_address >= end &&
+                   r.start_address - end <= max_gap &&
+                   r.start_address + r.register_count - first->start_address <= MAX_READ_REGISTERS &&
+                   this->is_mergeable_(*first) && this->is_mergeable_(r);
+      if (!merge) {
+        this->update_ranges_(ranges);
+        ranges.clear();
+      }
+    }
+    ranges.push_back(&r);
   }
+  if (!ranges.empty())
+    this->update_ranges_(ranges);
 }
 
 // walk through the sensors and determine the register ranges to read
@@ -262,9 +388,9 @@ size_t ModbusController::create_register_ranges_() {
       r.start_address = curr->start_address;
       r.register_count = curr->register_count;
       r.register_type = curr->register_type;
-      r.sensors.insert(curr);
       r.skip_updates = curr->skip_updates;
       r.skip_updates_counter = 0;
+      r.force_new_range = curr->force_new_range;
       buffer_offset = curr->get_register_size();
 
       ESP_LOGV(TAG, "Started new range");
@@ -322,7 +448,7 @@ size_t ModbusController::create_register_ranges_() {
       }
 
       // add sensor to this range
-      r.sensors.insert(curr);
+      r.sensors.push_back(curr);
 
       ix++;
     } else {
@@ -342,6 +468,18 @@ size_t ModbusController::create_register_ranges_() {
     register_ranges_.push_back(r);
   }
 
+  for (auto &range : register_ranges_) {
+    // sensors whose start address was changed while building the range were visited out of order
+    std::sort(range.sensors.begin(), range.sensors.end(), SensorItemsComparator());
+    range.sensors.erase(std::unique(range.sensors.begin(), range.sensors.end()), range.sensors.end());
+  }
+  // sort for the binary search in find_range_(), ranges with the same start address keep their order
+  std::stable_sort(register_ranges_.begin(), register_ranges_.end(),
+                   [](const RegisterRange &a, const RegisterRange &b) {
+                     return std::make_pair(a.register_type, a.start_address) <
+                            std::make_pair(b.register_type, b.start_address);
+                   });
+
   return register_ranges_.size();
 }
 
@@ -304,9 +304,10 @@ struct RegisterRange {
   uint16_t start_address;
   ModbusRegisterType register_type;
   uint8_t register_count;
-  uint16_t skip_updates;          // the config value
-  SensorSet sensors;              // all sensors of this range
-  uint16_t skip_updates_counter;  // the running value
+  uint16_t skip_updates;              // the config value
+  bool force_new_range;               // the first sensor asked for a range of its own, it is never merged
+  std::vector<SensorItem *> sensors;  // all sensors of this range, ordered by SensorItemsComparator
+  uint16_t skip_updates_counter;      // the running value
 };
 
 class ModbusCommandItem {
@@ -323,6 +324,8 @@ class ModbusCommandItem {
   bool send();
   /// Check if the command should be retried based on the max_retries parameter
   bool should_retry(uint8_t max_retries) { return this->send_count_ <= max_retries; };
+  /// How many times this command has been sent without getting a response
+  uint8_t get_send_count() const { return this->send_count_; }
 
   /// factory methods
   /** Create modbus read command
@@ -441,7 +444,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   /// Registers a server register with the controller. Called by esphomes code generator
   void add_server_register(ServerRegister *server_register) { server_registers_.push_back(server_register); }
   /// called when a modbus response was parsed without errors
-  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_frame(const uint8_t *data, size_t len) override;
+  void on_modbus_data(const std::vector<uint8_t> &data) override { this->on_modbus_frame(data.data(), data.size()); }
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
   /// called when a modbus request (function code 3 or 4) was parsed without errors
@@ -460,6 +464,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool get_allow_duplicate_commands() { return this->allow_duplicate_commands_; }
   /// called by esphome generated code to set the command_throttle period
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
+  /// called by esphome generated code to allow reading unused registers between ranges in a single command
+  void set_merge_register_gaps(bool merge_register_gaps) { this->merge_register_gaps_ = merge_register_gaps; }
   /// called by esphome generated code to set the offline_skip_updates
   void set_offline_skip_updates(uint16_t offline_skip_updates) { this->offline_skip_updates_ = offline_skip_updates; }
   /// get the number of queued modbus commands (should be mostly empty)
@@ -480,10 +486,23 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
-  // find register in sensormap. Returns iterator with all registers having the same start address
-  SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
+  /// find the range of registers with this start address, nullptr if there is none
+  RegisterRange *find_range_(ModbusRegisterType register_type, uint16_t start_address);
   /// submit the read command for the address range to the send queue
   void update_range_(RegisterRange &r);
+  /// submit a single read command covering all ranges, which are of the same type and sorted by start address
+  void update_ranges_(const std::vector<RegisterRange *> &ranges);
+  /// dispatch the response of a read command covering several ranges to the sensors of each range
+  void on_merged_register_data_(ModbusRegisterType register_type, uint16_t start_address,
+                                const std::vector<uint16_t> &range_starts, const std::vector<uint8_t> &data);
+  /// if the range may be read together with other ranges by a single command
+  bool is_mergeable_(const RegisterRange &r) const;
+  /// if the command is a read command covering more than one range
+  bool is_merged_read_(const ModbusCommandItem &command) const;
+  /// largest number of unused registers between two ranges for which a merged read is faster than two commands
+  uint16_t max_register_gap_() const;
+  /// time in ms to transfer a number of bytes over the bus
+  uint32_t transfer_time_(size_t bytes) const;
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
   /// send the next modbus command from the send queue
@@ -494,7 +513,7 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   SensorSet sensorset_;
   /// Collection of all server registers for this component
   std::vector<ServerRegister *> server_registers_;
-  /// Continuous range of modbus registers
+  /// Continuous range of modbus registers, sorted by register type and start address
   std::vector<RegisterRange> register_ranges_;
   /// Hold the pending requests to be sent
   std::list<std::unique_ptr<ModbusCommandItem>> command_queue_;
@@ -506,6 +525,12 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   uint32_t last_command_timestamp_;
   /// min time in ms between sending modbus commands
   uint16_t command_throttle_;
+  /// time in ms added to command_throttle_ while the device misses responses
+  uint16_t throttle_backoff_{0};
+  /// smoothed time in ms the device takes to respond on top of the transfer time, 0 until measured
+  uint32_t turnaround_{0};
+  /// if ranges separated by a few unused registers are read by a single command
+  bool merge_register_gaps_{false};
   /// if module didn't respond the last command
   bool module_offline_;
   /// how many updates to skip if module is offline
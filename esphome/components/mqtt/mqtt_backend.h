@@ -1,6 +1,7 @@
 #pragma once
 #include "esphome/core/defines.h"
 #ifdef USE_MQTT
+#include <cstdint>
 #include <string>
 #include <map>
 #include "esphome/components/network/ip_address.h"
@@ -62,6 +63,12 @@ class MQTTBackend {
                    message.retain);
   }
 
+  /** Number of bytes that can be published right now without queueing behind earlier messages.
+   *
+   * Used to pace low priority traffic like discovery messages. Backends that can't tell return SIZE_MAX.
+   */
+  virtual size_t get_outbound_space() const { return SIZE_MAX; }
+
   // called from MQTTClient::loop()
   virtual void loop() {}
 };
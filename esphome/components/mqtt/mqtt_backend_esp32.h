@@ -45,6 +45,8 @@ struct Event {
 class MQTTBackendESP32 final : public MQTTBackend {
  public:
   static const size_t MQTT_BUFFER_SIZE = 4096;
+  /// Bytes of unsent or unacknowledged messages in the outbox above which low priority messages are held back.
+  static const size_t MAX_OUTBOX_SIZE = 2 * MQTT_BUFFER_SIZE;
 
   void set_keep_alive(uint16_t keep_alive) final { this->keep_alive_ = keep_alive; }
   void set_client_id(const char *client_id) final { this->client_id_ = client_id; }
@@ -122,6 +124,13 @@ class MQTTBackendESP32 final : public MQTTBackend {
   }
   using MQTTBackend::publish;
 
+  size_t get_outbound_space() const final {
+    if (!this->is_initalized_)
+      return 0;
+    int outbox_size = esp_mqtt_client_get_outbox_size(this->handler_.get());
+    return outbox_size < 0 || (size_t) outbox_size >= MAX_OUTBOX_SIZE ? 0 : MAX_OUTBOX_SIZE - outbox_size;
+  }
+
   void loop() final;
 
   void set_ca_certificate(const std::string &cert) { ca_certificate_ = cert; }
@@ -0,0 +1,490 @@
+#include "mqtt_backend_host.h"
+
+#ifdef USE_MQTT
+#ifdef USE_HOST
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace mqtt {
+
+static const char *const TAG = "mqtt.host";
+
+/// Time after which an unacknowledged QoS 1 message is sent again.
+static const uint32_t INFLIGHT_RESEND_TIMEOUT = 10000;
+static const size_t RX_CHUNK_SIZE = 1460;
+
+/// MQTT control packet types, the upper nibble of the fixed header.
+enum MQTTPacketType : uint8_t {
+  MQTT_CONNECT = 1,
+  MQTT_CONNACK = 2,
+  MQTT_PUBLISH = 3,
+  MQTT_PUBACK = 4,
+  MQTT_PUBREC = 5,
+  MQTT_PUBREL = 6,
+  MQTT_PUBCOMP = 7,
+  MQTT_SUBSCRIBE = 8,
+  MQTT_SUBACK = 9,
+  MQTT_UNSUBSCRIBE = 10,
+  MQTT_UNSUBACK = 11,
+  MQTT_PINGREQ = 12,
+  MQTT_PINGRESP = 13,
+  MQTT_DISCONNECT = 14,
+};
+
+static const uint8_t MQTT_PUBLISH_DUP = 0x08;
+/// Flags that the specification mandates for SUBSCRIBE, UNSUBSCRIBE and PUBREL.
+static const uint8_t MQTT_RESERVED_FLAGS = 0x02;
+
+static uint16_t read_u16(const uint8_t *data) { return (uint16_t(data[0]) << 8) | data[1]; }
+
+void MQTTBackendHost::connect() {
+  this->close_(false, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+  if (this->clean_session_)
+    this->inflight_.clear();
+
+  struct addrinfo hints {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  char port[6];
+  snprintf(port, sizeof(port), "%u", this->port_);
+  struct addrinfo *res = nullptr;
+  // getaddrinfo() blocks, which is acceptable on the host platform
+  int err = getaddrinfo(this->host_.c_str(), port, &hints, &res);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Resolving '%s' failed: %s", this->host_.c_str(), gai_strerror(err));
+    return;
+  }
+
+  for (struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
+    int fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
+      continue;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0 || errno == EINPROGRESS) {
+      this->fd_ = fd;
+      break;
+    }
+    ::close(fd);
+  }
+  freeaddrinfo(res);
+
+  if (this->fd_ < 0) {
+    ESP_LOGW(TAG, "Connecting to %s:%u failed: %s", this->host_.c_str(), this->port_, strerror(errno));
+    return;
+  }
+  this->state_ = STATE_TCP_CONNECTING;
+}
+
+void MQTTBackendHost::disconnect() {
+  if (this->fd_ < 0)
+    return;
+  bool was_connected = this->state_ == STATE_CONNECTED;
+  if (was_connected) {
+    this->begin_packet_(MQTT_DISCONNECT << 4, 0);
+    this->flush_();
+  }
+  this->close_(was_connected, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+}
+
+bool MQTTBackendHost::subscribe(const char *topic, uint8_t qos) {
+  size_t topic_len = strlen(topic);
+  if (!this->connected() || !this->has_tx_space_(topic_len + 10))
+    return false;
+  this->begin_packet_((MQTT_SUBSCRIBE << 4) | MQTT_RESERVED_FLAGS, 2 + 2 + topic_len + 1);
+  this->write_u16_(this->next_packet_id_());
+  this->write_string_(topic, topic_len);
+  // incoming QoS 2 isn't supported, let the broker downgrade
+  this->tx_buffer_.push_back(std::min<uint8_t>(qos, 1));
+  return this->flush_();
+}
+
+bool MQTTBackendHost::unsubscribe(const char *topic) {
+  size_t topic_len = strlen(topic);
+  if (!this->connected() || !this->has_tx_space_(topic_len + 9))
+    return false;
+  this->begin_packet_((MQTT_UNSUBSCRIBE << 4) | MQTT_RESERVED_FLAGS, 2 + 2 + topic_len);
+  this->write_u16_(this->next_packet_id_());
+  this->write_string_(topic, topic_len);
+  return this->flush_();
+}
+
+bool MQTTBackendHost::publish(const char *topic, const char *payload, size_t length, uint8_t qos, bool retain) {
+  if (!this->connected())
+    return false;
+  // QoS 2 is sent as QoS 1
+  qos = std::min<uint8_t>(qos, 1);
+  if (qos > 0 && this->inflight_.size() >= this->max_inflight_)
+    return false;
+  size_t topic_len = strlen(topic);
+  size_t remaining_length = 2 + topic_len + (qos > 0 ? 2 : 0) + length;
+  if (!this->has_tx_space_(remaining_length + 5))
+    return false;
+
+  size_t start = this->begin_packet_((MQTT_PUBLISH << 4) | (qos << 1) | (retain ? 1 : 0), remaining_length);
+  this->write_string_(topic, topic_len);
+  uint16_t packet_id = 0;
+  if (qos > 0) {
+    packet_id = this->next_packet_id_();
+    this->write_u16_(packet_id);
+  }
+  this->tx_buffer_.insert(this->tx_buffer_.end(), payload, payload + length);
+  if (qos > 0) {
+    // keep a copy until the broker acknowledges it
+    this->inflight_.push_back(InflightMessage{
+        .packet_id = packet_id,
+        .sent_at = millis(),
+        .packet = std::vector<uint8_t>(this->tx_buffer_.begin() + start, this->tx_buffer_.end()),
+    });
+  }
+  return this->flush_();
+}
+
+void MQTTBackendHost::loop() {
+  if (this->fd_ < 0)
+    return;
+  const uint32_t now = millis();
+
+  if (this->state_ == STATE_TCP_CONNECTING) {
+    struct pollfd pfd {
+      .fd = this->fd_, .events = POLLOUT, .revents = 0
+    };
+    if (poll(&pfd, 1, 0) <= 0)
+      return;
+    int err = 0;
+    socklen_t err_len = sizeof(err);
+    getsockopt(this->fd_, SOL_SOCKET, SO_ERROR, &err, &err_len);
+    if (err != 0) {
+      ESP_LOGW(TAG, "Connecting to %s:%u failed: %s", this->host_.c_str(), this->port_, strerror(err));
+      this->close_(true, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+      return;
+    }
+    this->send_connect_();
+    this->state_ = STATE_WAIT_CONNACK;
+    this->last_received_ = now;
+  }
+
+  if (!this->read_()) {
+    this->close_(true, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+    return;
+  }
+  if (this->fd_ < 0)
+    return;
+
+  if (this->state_ == STATE_CONNECTED) {
+    const uint32_t interval = this->keep_alive_ * 1000u;
+    if (interval != 0) {
+      if (this->ping_outstanding_ && now - this->last_ping_ > interval) {
+        ESP_LOGW(TAG, "Broker didn't answer the keep-alive ping");
+        this->close_(true, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+        return;
+      }
+      if (!this->ping_outstanding_ && (now - this->last_sent_ >= interval || now - this->last_received_ >= interval)) {
+        this->begin_packet_(MQTT_PINGREQ << 4, 0);
+        this->ping_outstanding_ = true;
+        this->last_ping_ = now;
+      }
+    }
+    this->resend_inflight_(now, false);
+  }
+
+  if (!this->flush_())
+    this->close_(true, MQTTClientDisconnectReason::TCP_DISCONNECTED);
+}
+
+void MQTTBackendHost::close_(bool notify, MQTTClientDisconnectReason reason) {
+  if (this->fd_ >= 0)
+    ::close(this->fd_);
+  this->fd_ = -1;
+  this->state_ = STATE_DISCONNECTED;
+  this->tx_buffer_.clear();
+  this->tx_offset_ = 0;
+  this->rx_buffer_.clear();
+  this->ping_outstanding_ = false;
+  if (notify)
+    this->on_disconnect_.call(reason);
+}
+
+void MQTTBackendHost::send_connect_() {
+  uint8_t flags = 0;
+  size_t remaining_length = 10 + 2 + this->client_id_.size();
+  if (this->clean_session_)
+    flags |= 0x02;
+  if (!this->lwt_topic_.empty()) {
+    flags |= 0x04 | ((this->lwt_qos_ & 0x03) << 3) | (this->lwt_retain_ ? 0x20 : 0);
+    remaining_length += 2 + this->lwt_topic_.size() + 2 + this->lwt_message_.size();
+  }
+  if (!this->username_.empty()) {
+    flags |= 0x80;
+    remaining_length += 2 + this->username_.size();
+    if (!this->password_.empty()) {
+      flags |= 0x40;
+      remaining_length += 2 + this->password_.size();
+    }
+  }
+
+  this->begin_packet_(MQTT_CONNECT << 4, remaining_length);
+  this->write_string_("MQTT", 4);
+  this->tx_buffer_.push_back(4);  // protocol level 3.1.1
+  this->tx_buffer_.push_back(flags);
+  this->write_u16_(this->keep_alive_);
+  this->write_string_(this->client_id_.data(), this->client_id_.size());
+  if (!this->lwt_topic_.empty()) {
+    this->write_string_(this->lwt_topic_.data(), this->lwt_topic_.size());
+    this->write_string_(this->lwt_message_.data(), this->lwt_message_.size());
+  }
+  if (!this->username_.empty()) {
+    this->write_string_(this->username_.data(), this->username_.size());
+    if (!this->password_.empty())
+      this->write_string_(this->password_.data(), this->password_.size());
+  }
+}
+
+size_t MQTTBackendHost::begin_packet_(uint8_t header, size_t remaining_length) {
+  size_t start = this->tx_buffer_.size();
+  this->tx_buffer_.push_back(header);
+  do {
+    uint8_t encoded = remaining_length % 128;
+    remaining_length /= 128;
+    if (remaining_length > 0)
+      encoded |= 0x80;
+    this->tx_buffer_.push_back(encoded);
+  } while (remaining_length > 0);
+  return start;
+}
+
+void MQTTBackendHost::write_u16_(uint16_t value) {
+  this->tx_buffer_.push_back(value >> 8);
+  this->tx_buffer_.push_back(value & 0xFF);
+}
+
+void MQTTBackendHost::write_string_(const char *str, size_t len) {
+  this->write_u16_(len);
+  this->tx_buffer_.insert(this->tx_buffer_.end(), str, str + len);
+}
+
+void MQTTBackendHost::write_packet_id_packet_(uint8_t header, uint16_t packet_id) {
+  this->begin_packet_(header, 2);
+  this->write_u16_(packet_id);
+}
+
+size_t MQTTBackendHost::get_outbound_space() const {
+  if (!this->connected() || this->inflight_.size() >= this->max_inflight_)
+    return 0;
+  return MAX_TX_BUFFER_SIZE - (this->tx_buffer_.size() - this->tx_offset_);
+}
+
+bool MQTTBackendHost::has_tx_space_(size_t len) const {
+  return this->tx_buffer_.size() - this->tx_offset_ + len <= MAX_TX_BUFFER_SIZE;
+}
+
+bool MQTTBackendHost::flush_() {
+  if (this->state_ == STATE_TCP_CONNECTING)
+    return true;
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+  while (this->tx_offset_ < this->tx_buffer_.size()) {
+    ssize_t sent = ::send(this->fd_, this->tx_buffer_.data() + this->tx_offset_,
+                          this->tx_buffer_.size() - this->tx_offset_, flags);
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        break;
+      ESP_LOGW(TAG, "Sending failed: %s", strerror(errno));
+      return false;
+    }
+    this->tx_offset_ += sent;
+    this->last_sent_ = millis();
+  }
+
+  if (this->tx_offset_ == this->tx_buffer_.size()) {
+    this->tx_buffer_.clear();
+    this->tx_offset_ = 0;
+  } else if (this->tx_offset_ > this->tx_buffer_.size() / 2) {
+    this->tx_buffer_.erase(this->tx_buffer_.begin(), this->tx_buffer_.begin() + this->tx_offset_);
+    this->tx_offset_ = 0;
+  }
+  return true;
+}
+
+bool MQTTBackendHost::read_() {
+  while (true) {
+    size_t old_size = this->rx_buffer_.size();
+    this->rx_buffer_.resize(old_size + RX_CHUNK_SIZE);
+    ssize_t received = ::recv(this->fd_, this->rx_buffer_.data() + old_size, RX_CHUNK_SIZE, 0);
+    if (received > 0) {
+      this->rx_buffer_.resize(old_size + received);
+      this->last_received_ = millis();
+      continue;
+    }
+    this->rx_buffer_.resize(old_size);
+    if (received == 0) {
+      ESP_LOGW(TAG, "Connection closed by broker");
+      return false;
+    }
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+      break;
+    ESP_LOGW(TAG, "Receiving failed: %s", strerror(errno));
+    return false;
+  }
+
+  size_t pos = 0;
+  while (this->rx_buffer_.size() - pos >= 2) {
+    const uint8_t *packet = this->rx_buffer_.data() + pos;
+    size_t available = this->rx_buffer_.size() - pos;
+    size_t remaining_length = 0;
+    size_t header_len = 1;
+    bool complete_length = false;
+    for (uint8_t shift = 0; header_len < available && header_len <= 4; shift += 7) {
+      uint8_t encoded = packet[header_len++];
+      remaining_length |= size_t(encoded & 0x7F) << shift;
+      if ((encoded & 0x80) == 0) {
+        complete_length = true;
+        break;
+      }
+    }
+    if (!complete_length) {
+      if (header_len > 4) {
+        ESP_LOGW(TAG, "Malformed packet length");
+        return false;
+      }
+      break;
+    }
+    if (available - header_len < remaining_length)
+      break;
+
+    if (!this->handle_packet_(packet[0], packet + header_len, remaining_length))
+      return false;
+    if (this->fd_ < 0) {
+      // a callback closed the connection, the buffer is gone
+      return true;
+    }
+    pos += header_len + remaining_length;
+  }
+  this->rx_buffer_.erase(this->rx_buffer_.begin(), this->rx_buffer_.begin() + pos);
+  return true;
+}
+
+bool MQTTBackendHost::handle_packet_(uint8_t header, const uint8_t *data, size_t len) {
+  uint8_t type = header >> 4;
+  if (type != MQTT_PUBLISH && type != MQTT_PINGRESP && len < 2) {
+    ESP_LOGW(TAG, "Malformed packet of type %u", type);
+    return false;
+  }
+
+  switch (type) {
+    case MQTT_CONNACK: {
+      if (this->state_ != STATE_WAIT_CONNACK)
+        return false;
+      if (data[1] != 0) {
+        ESP_LOGW(TAG, "Connection refused, return code %u", data[1]);
+        // return codes 1-5 match MQTTClientDisconnectReason
+        this->close_(true, static_cast<MQTTClientDisconnectReason>(data[1]));
+        return true;
+      }
+      bool session_present = data[0] & 0x01;
+      this->state_ = STATE_CONNECTED;
+      this->ping_outstanding_ = false;
+      // messages that were in flight when the connection dropped
+      this->resend_inflight_(millis(), true);
+      this->on_connect_.call(session_present);
+      break;
+    }
+    case MQTT_PUBLISH:
+      this->handle_publish_(header, data, len);
+      break;
+    case MQTT_PUBACK: {
+      uint16_t packet_id = read_u16(data);
+      for (auto it = this->inflight_.begin(); it != this->inflight_.end(); ++it) {
+        if (it->packet_id == packet_id) {
+          this->inflight_.erase(it);
+          break;
+        }
+      }
+      this->on_publish_.call(packet_id);
+      break;
+    }
+    case MQTT_PUBREL:
+      // second half of an incoming QoS 2 message, which was delivered on PUBLISH
+      this->write_packet_id_packet_(MQTT_PUBCOMP << 4, read_u16(data));
+      break;
+    case MQTT_SUBACK:
+      this->on_subscribe_.call(read_u16(data), len >= 3 ? data[2] : 0);
+      break;
+    case MQTT_UNSUBACK:
+      this->on_unsubscribe_.call(read_u16(data));
+      break;
+    case MQTT_PINGRESP:
+      this->ping_outstanding_ = false;
+      break;
+    case MQTT_PUBREC:
+    default:
+      ESP_LOGV(TAG, "Ignoring packet of type %u", type);
+      break;
+  }
+  return true;
+}
+
+void MQTTBackendHost::handle_publish_(uint8_t header, const uint8_t *data, size_t len) {
+  uint8_t qos = (header >> 1) & 0x03;
+  if (len < 2)
+    return;
+  size_t topic_len = read_u16(data);
+  size_t pos = 2 + topic_len;
+  if (pos + (qos > 0 ? 2 : 0) > len)
+    return;
+  this->rx_topic_.assign(reinterpret_cast<const char *>(data + 2), topic_len);
+  if (qos == 1) {
+    this->write_packet_id_packet_(MQTT_PUBACK << 4, read_u16(data + pos));
+    pos += 2;
+  } else if (qos == 2) {
+    this->write_packet_id_packet_(MQTT_PUBREC << 4, read_u16(data + pos));
+    pos += 2;
+  }
+
+  const char *payload = reinterpret_cast<const char *>(data + pos);
+  size_t payload_len = len - pos;
+  ESP_LOGV(TAG, "Received message on '%s' (%zu bytes)", this->rx_topic_.c_str(), payload_len);
+  this->on_message_.call(this->rx_topic_.c_str(), payload, payload_len, 0, payload_len);
+}
+
+void MQTTBackendHost::resend_inflight_(uint32_t now, bool all) {
+  for (auto &message : this->inflight_) {
+    if (!all && now - message.sent_at < INFLIGHT_RESEND_TIMEOUT)
+      continue;
+    if (!this->has_tx_space_(message.packet.size()))
+      break;
+    message.packet[0] |= MQTT_PUBLISH_DUP;
+    message.sent_at = now;
+    this->tx_buffer_.insert(this->tx_buffer_.end(), message.packet.begin(), message.packet.end());
+  }
+}
+
+uint16_t MQTTBackendHost::next_packet_id_() {
+  if (++this->last_packet_id_ == 0)
+    this->last_packet_id_ = 1;
+  return this->last_packet_id_;
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_HOST
+#endif  // USE_MQTT
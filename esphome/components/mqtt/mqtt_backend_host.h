@@ -0,0 +1,155 @@
+#pragma once
+
+#include "mqtt_backend.h"
+#ifdef USE_MQTT
+#ifdef USE_HOST
+
+#include <string>
+#include <vector>
+#include "esphome/components/network/ip_address.h"
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace mqtt {
+
+/** MQTT 3.1.1 client over plain POSIX sockets for the host platform.
+ *
+ * Everything runs from loop() on non-blocking sockets. Outgoing QoS 1 messages are kept until they are acknowledged
+ * by the broker, with at most max_inflight of them in flight; publish() returns false while the window is full so the
+ * caller retries later. Unacknowledged messages are re-sent with the DUP flag after a timeout and after reconnecting
+ * to a persistent session. Subscriptions are capped to QoS 1.
+ */
+class MQTTBackendHost final : public MQTTBackend {
+ public:
+  /// Default number of unacknowledged QoS 1 messages.
+  static const size_t DEFAULT_MAX_INFLIGHT = 16;
+  /// Outgoing bytes that may be queued before publish() starts to fail.
+  static const size_t MAX_TX_BUFFER_SIZE = 64 * 1024;
+
+  void set_keep_alive(uint16_t keep_alive) final { this->keep_alive_ = keep_alive; }
+  void set_client_id(const char *client_id) final { this->client_id_ = client_id; }
+  void set_clean_session(bool clean_session) final { this->clean_session_ = clean_session; }
+  void set_credentials(const char *username, const char *password) final {
+    this->username_ = username != nullptr ? username : "";
+    this->password_ = password != nullptr ? password : "";
+  }
+  void set_will(const char *topic, uint8_t qos, bool retain, const char *payload) final {
+    this->lwt_topic_ = topic != nullptr ? topic : "";
+    this->lwt_qos_ = qos;
+    this->lwt_message_ = payload != nullptr ? payload : "";
+    this->lwt_retain_ = retain;
+  }
+  void set_server(network::IPAddress ip, uint16_t port) final {
+    this->host_ = ip.str();
+    this->port_ = port;
+  }
+  void set_server(const char *host, uint16_t port) final {
+    this->host_ = host;
+    this->port_ = port;
+  }
+  void set_on_connect(std::function<on_connect_callback_t> &&callback) final {
+    this->on_connect_.add(std::move(callback));
+  }
+  void set_on_disconnect(std::function<on_disconnect_callback_t> &&callback) final {
+    this->on_disconnect_.add(std::move(callback));
+  }
+  void set_on_subscribe(std::function<on_subscribe_callback_t> &&callback) final {
+    this->on_subscribe_.add(std::move(callback));
+  }
+  void set_on_unsubscribe(std::function<on_unsubscribe_callback_t> &&callback) final {
+    this->on_unsubscribe_.add(std::move(callback));
+  }
+  void set_on_message(std::function<on_message_callback_t> &&callback) final {
+    this->on_message_.add(std::move(callback));
+  }
+  void set_on_publish(std::function<on_publish_user_callback_t> &&callback) final {
+    this->on_publish_.add(std::move(callback));
+  }
+  bool connected() const final { return this->state_ == STATE_CONNECTED; }
+
+  void connect() final;
+  void disconnect() final;
+  bool subscribe(const char *topic, uint8_t qos) final;
+  bool unsubscribe(const char *topic) final;
+  bool publish(const char *topic, const char *payload, size_t length, uint8_t qos, bool retain) final;
+  using MQTTBackend::publish;
+  size_t get_outbound_space() const final;
+
+  void loop() final;
+
+  void set_max_inflight(size_t max_inflight) { this->max_inflight_ = max_inflight; }
+  /// Number of QoS 1 messages waiting for their PUBACK.
+  size_t get_inflight_count() const { return this->inflight_.size(); }
+
+ protected:
+  enum State : uint8_t {
+    STATE_DISCONNECTED = 0,
+    STATE_TCP_CONNECTING,
+    STATE_WAIT_CONNACK,
+    STATE_CONNECTED,
+  };
+
+  /// A QoS 1 PUBLISH that hasn't been acknowledged yet.
+  struct InflightMessage {
+    uint16_t packet_id;
+    uint32_t sent_at;
+    std::vector<uint8_t> packet;
+  };
+
+  void close_(bool notify, MQTTClientDisconnectReason reason);
+  void send_connect_();
+  /// Start a packet in tx_buffer_ with the fixed header for a remaining length, returns its offset.
+  size_t begin_packet_(uint8_t header, size_t remaining_length);
+  void write_u16_(uint16_t value);
+  void write_string_(const char *str, size_t len);
+  void write_packet_id_packet_(uint8_t header, uint16_t packet_id);
+  bool has_tx_space_(size_t len) const;
+  bool flush_();
+  bool read_();
+  /// Handle a complete packet, returns false if the connection must be dropped.
+  bool handle_packet_(uint8_t header, const uint8_t *data, size_t len);
+  void handle_publish_(uint8_t header, const uint8_t *data, size_t len);
+  void resend_inflight_(uint32_t now, bool all);
+  uint16_t next_packet_id_();
+
+  int fd_{-1};
+  State state_{STATE_DISCONNECTED};
+  uint32_t last_sent_{0};
+  uint32_t last_received_{0};
+  uint32_t last_ping_{0};
+  bool ping_outstanding_{false};
+  uint16_t last_packet_id_{0};
+
+  std::vector<uint8_t> tx_buffer_;
+  size_t tx_offset_{0};
+  std::vector<uint8_t> rx_buffer_;
+  std::string rx_topic_;
+  std::vector<InflightMessage> inflight_;
+  size_t max_inflight_{DEFAULT_MAX_INFLIGHT};
+
+  std::string host_;
+  uint16_t port_{1883};
+  std::string username_;
+  std::string password_;
+  std::string lwt_topic_;
+  std::string lwt_message_;
+  uint8_t lwt_qos_{0};
+  bool lwt_retain_{false};
+  std::string client_id_;
+  uint16_t keep_alive_{15};
+  bool clean_session_{true};
+
+  // callbacks
+  CallbackManager<on_connect_callback_t> on_connect_;
+  CallbackManager<on_disconnect_callback_t> on_disconnect_;
+  CallbackManager<on_subscribe_callback_t> on_subscribe_;
+  CallbackManager<on_unsubscribe_callback_t> on_unsubscribe_;
+  CallbackManager<on_message_callback_t> on_message_;
+  CallbackManager<on_publish_user_callback_t> on_publish_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif
+#endif
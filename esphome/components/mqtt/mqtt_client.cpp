@@ -2,6 +2,7 @@
 
 #ifdef USE_MQTT
 
+#include <algorithm>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
@@ -11,8 +12,10 @@
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
 #endif
+#ifndef USE_HOST
 #include "lwip/dns.h"
 #include "lwip/err.h"
+#endif
 #include "mqtt_component.h"
 
 #ifdef USE_API
@@ -27,6 +30,13 @@ namespace mqtt {
 
 static const char *const TAG = "mqtt";
 
+/// Discovery messages that are serialized ahead of being published.
+static const size_t MAX_QUEUED_DISCOVERY = 4;
+/// Outbound bytes kept free for state and availability messages while discovery messages are sent.
+static const size_t DISCOVERY_OUTBOUND_RESERVE = 1024;
+/// Time the broker gets to deliver our retained discovery messages before the first one is sent.
+static const uint32_t RETAINED_DISCOVERY_TIMEOUT = 1000;
+
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
   this->credentials_.client_id = App.get_name() + "-" + get_mac_address();
@@ -37,16 +47,19 @@ void MQTTClientComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up MQTT...");
   this->mqtt_backend_.set_on_message(
       [this](const char *topic, const char *payload, size_t len, size_t index, size_t total) {
-        if (index == 0)
+        if (index == 0) {
+          // the buffers keep their capacity, so messages usually don't need any allocation
+          this->payload_buffer_.clear();
           this->payload_buffer_.reserve(total);
+        }
 
         // append new payload, may contain incomplete MQTT message
         this->payload_buffer_.append(payload, len);
 
         // MQTT fully received
         if (len + index == total) {
-          this->on_message(topic, this->payload_buffer_);
-          this->payload_buffer_.clear();
+          this->topic_buffer_.assign(topic);
+          this->on_message(this->topic_buffer_, this->payload_buffer_);
         }
       });
   this->mqtt_backend_.set_on_disconnect([this](MQTTClientDisconnectReason reason) {
@@ -59,10 +72,8 @@ void MQTTClientComponent::setup() {
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
       if (level <= this->log_level_ && this->is_connected()) {
-        this->publish({.topic = this->log_message_.topic,
-                       .payload = message,
-                       .qos = this->log_message_.qos,
-                       .retain = this->log_message_.retain});
+        this->publish(this->log_message_.topic, message, strlen(message), this->log_message_.qos,
+                      this->log_message_.retain);
       }
     });
   }
@@ -120,6 +131,9 @@ void MQTTClientComponent::send_device_info_() {
 #ifdef USE_LIBRETINY
         root["platform"] = lt_cpu_get_model_name();
 #endif
+#ifdef USE_HOST
+        root["platform"] = "host";
+#endif
 
         root["board"] = ESPHOME_BOARD;
 #if defined(USE_WIFI)
@@ -179,6 +193,10 @@ void MQTTClientComponent::start_dnslookup_() {
   this->status_set_warning();
   this->dns_resolve_error_ = false;
   this->dns_resolved_ = false;
+#ifdef USE_HOST
+  // The host backend resolves the broker address itself when connecting
+  this->dns_resolved_ = true;
+#else
   ip_addr_t addr;
 #if USE_NETWORK_IPV6
   err_t err = dns_gethostbyname_addrtype(this->credentials_.address.c_str(), &addr,
@@ -207,6 +225,7 @@ void MQTTClientComponent::start_dnslookup_() {
       break;
     }
   }
+#endif
 
   this->state_ = MQTT_CLIENT_RESOLVING_ADDRESS;
   this->connect_begin_ = millis();
@@ -226,9 +245,12 @@ void MQTTClientComponent::check_dnslookup_() {
     return;
   }
 
+#ifndef USE_HOST
   ESP_LOGD(TAG, "Resolved broker IP address to %s", this->ip_.str().c_str());
+#endif
   this->start_connect_();
 }
+#ifndef USE_HOST
 #if defined(USE_ESP8266) && LWIP_VERSION_MAJOR == 1
 void MQTTClientComponent::dns_found_callback(const char *name, ip_addr_t *ipaddr, void *callback_arg) {
 #else
@@ -242,6 +264,7 @@ void MQTTClientComponent::dns_found_callback(const char *name, const ip_addr_t *
     a_this->dns_resolved_ = true;
   }
 }
+#endif
 
 void MQTTClientComponent::start_connect_() {
   if (!network::is_connected())
@@ -295,6 +318,11 @@ void MQTTClientComponent::check_connected() {
   this->resubscribe_subscriptions_();
   this->send_device_info_();
 
+  // all components queue their discovery again
+  this->connected_at_ = millis();
+  this->discovery_pending_.clear();
+  this->discovery_queue_.clear();
+  this->subscribe_retained_discovery_();
   for (MQTTComponent *component : this->children_)
     component->schedule_resend_state();
 }
@@ -369,6 +397,9 @@ void MQTTClientComponent::loop() {
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        // availability goes out before discovery
+        if (this->sent_birth_message_ || this->birth_message_.topic.empty())
+          this->process_discovery_queue_();
       }
       break;
   }
@@ -415,34 +446,42 @@ void MQTTClientComponent::resubscribe_subscriptions_() {
   }
 }
 
+void MQTTClientComponent::add_subscription_(MQTTSubscription &&subscription) {
+  this->resubscribe_subscription_(&subscription);
+  this->subscription_trie_.insert(subscription.topic, this->subscriptions_.size());
+  this->subscriptions_.push_back(std::move(subscription));
+}
+
 void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t callback, uint8_t qos) {
-  MQTTSubscription subscription{
+  this->add_subscription_({
       .topic = topic,
       .qos = qos,
       .callback = std::move(callback),
+      .view_callback = nullptr,
       .subscribed = false,
       .resubscribe_timeout = 0,
-  };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  });
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
   auto f = [callback](const std::string &topic, const std::string &payload) {
-    json::parse_json(payload, [topic, callback](JsonObject root) -> bool {
+    json::parse_json(payload, [&topic, &callback](JsonObject root) -> bool {
       callback(topic, root);
       return true;
     });
   };
-  MQTTSubscription subscription{
+  this->subscribe(topic, f, qos);
+}
+
+void MQTTClientComponent::subscribe_view(const std::string &topic, mqtt_view_callback_t callback, uint8_t qos) {
+  this->add_subscription_({
       .topic = topic,
       .qos = qos,
-      .callback = f,
+      .callback = nullptr,
+      .view_callback = std::move(callback),
       .subscribed = false,
       .resubscribe_timeout = 0,
-  };
-  this->resubscribe_subscription_(&subscription);
-  this->subscriptions_.push_back(subscription);
+  });
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -464,6 +503,88 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
       ++it;
     }
   }
+
+  // indices have shifted, rebuild the trie
+  this->subscription_trie_.clear();
+  for (size_t i = 0; i < this->subscriptions_.size(); i++)
+    this->subscription_trie_.insert(this->subscriptions_[i].topic, i);
+}
+
+// Discovery
+void MQTTClientComponent::queue_discovery(MQTTComponent *component) {
+  if (std::find(this->discovery_pending_.begin(), this->discovery_pending_.end(), component) !=
+      this->discovery_pending_.end())
+    return;
+  this->discovery_pending_.push_back(component);
+}
+
+void MQTTClientComponent::process_discovery_queue_() {
+  if (!this->retained_discovery_filter_.empty() && millis() - this->connected_at_ < RETAINED_DISCOVERY_TIMEOUT)
+    return;
+  if (this->discovery_pending_.empty() && this->discovery_queue_.empty()) {
+    // all components are discovered, no need to keep receiving our own discovery messages
+    this->unsubscribe_retained_discovery_();
+    return;
+  }
+
+  while (this->discovery_queue_.size() < MAX_QUEUED_DISCOVERY && !this->discovery_pending_.empty()) {
+    MQTTComponent *component = this->discovery_pending_.front();
+    this->discovery_pending_.pop_front();
+    QueuedDiscovery entry{.component = component, .message = {}};
+    component->build_discovery_message(entry.message);
+
+    auto retained = this->retained_discovery_.find(fnv1_hash(entry.message.topic));
+    if (retained != this->retained_discovery_.end() && retained->second == fnv1_hash(entry.message.payload)) {
+      ESP_LOGV(TAG, "Discovery for '%s' is up to date", entry.message.topic.c_str());
+      if (!component->get_retain() && !component->send_initial_state())
+        component->schedule_resend_state();
+      continue;
+    }
+    this->discovery_queue_.push_back(std::move(entry));
+  }
+  if (this->discovery_queue_.empty())
+    return;
+
+  // Only one message per loop, and only if the backend isn't busy, so that state and command traffic isn't held up.
+  QueuedDiscovery &entry = this->discovery_queue_.front();
+  size_t length = entry.message.topic.size() + entry.message.payload.size() + DISCOVERY_OUTBOUND_RESERVE;
+  if (this->mqtt_backend_.get_outbound_space() < length)
+    return;
+  if (!this->publish(entry.message))
+    return;
+  // states that aren't retained are sent after the discovery message
+  if (!entry.component->get_retain() && !entry.component->send_initial_state())
+    entry.component->schedule_resend_state();
+  this->discovery_queue_.pop_front();
+}
+
+void MQTTClientComponent::subscribe_retained_discovery_() {
+  this->retained_discovery_.clear();
+  if (!this->is_discovery_enabled() || !this->discovery_info_.retain || this->discovery_info_.clean)
+    return;
+  if (!this->retained_discovery_filter_.empty())
+    return;  // still subscribed from the previous connection, the broker sends the retained messages again
+
+  this->retained_discovery_filter_ = this->discovery_info_.prefix + "/+/" + str_sanitize(App.get_name()) + "/+/config";
+  this->subscribe_view(
+      this->retained_discovery_filter_,
+      [this](StringRef topic, StringRef payload) {
+        uint32_t key = fnv1_hash(topic.c_str(), topic.size());
+        if (payload.empty()) {
+          this->retained_discovery_.erase(key);
+        } else {
+          this->retained_discovery_[key] = fnv1_hash(payload.c_str(), payload.size());
+        }
+      },
+      0);
+}
+
+void MQTTClientComponent::unsubscribe_retained_discovery_() {
+  if (this->retained_discovery_filter_.empty())
+    return;
+  this->unsubscribe(this->retained_discovery_filter_);
+  this->retained_discovery_filter_.clear();
+  this->retained_discovery_.clear();
 }
 
 // Publish
@@ -473,35 +594,35 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  return publish({.topic = topic, .payload = payload, .qos = qos, .retain = retain});
-}
-
-bool MQTTClientComponent::publish(const MQTTMessage &message) {
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = this->log_message_.topic == message.topic;
-  bool ret = this->mqtt_backend_.publish(message);
+  bool logging_topic = this->log_message_.topic == topic;
+  bool ret = this->mqtt_backend_.publish(topic.c_str(), payload, payload_length, qos, retain);
   delay(0);
   if (!ret && !logging_topic && this->is_connected()) {
     delay(0);
-    ret = this->mqtt_backend_.publish(message);
+    ret = this->mqtt_backend_.publish(topic.c_str(), payload, payload_length, qos, retain);
     delay(0);
   }
 
   if (!logging_topic) {
     if (ret) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d qos=%d)", message.topic.c_str(), message.payload.c_str(),
-               message.retain, message.qos);
+      ESP_LOGV(TAG, "Publish(topic='%s' payload='%.*s' retain=%d qos=%d)", topic.c_str(), (int) payload_length,
+               payload, retain, qos);
     } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", message.topic.c_str(),
-               message.payload.length());
+      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", topic.c_str(), payload_length);
       this->status_momentary_warning("publish", 1000);
     }
   }
   return ret != 0;
 }
+
+bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic, message.payload.data(), message.payload.size(), message.qos, message.retain);
+}
+
 bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
                                        bool retain) {
   std::string message = json::build_json(f);
@@ -525,76 +646,29 @@ void MQTTClientComponent::disable() {
   this->on_shutdown();
 }
 
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
-
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
-  }
-
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
-  }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
-}
-
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
-}
-
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
 #ifdef USE_ESP8266
   // on ESP8266, this is called in lwIP/AsyncTCP task; some components do not like running
   // from a different task.
-  this->defer([this, topic, payload]() {
+  this->defer([this, topic, payload]() { this->dispatch_message_(topic, payload); });
+#else
+  this->dispatch_message_(topic, payload);
 #endif
-    for (auto &subscription : this->subscriptions_) {
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
+}
+
+void MQTTClientComponent::dispatch_message_(const std::string &topic, const std::string &payload) {
+  this->matched_subscriptions_.clear();
+  this->subscription_trie_.match(topic.c_str(), this->matched_subscriptions_);
+  // call the callbacks in the order of subscription
+  std::sort(this->matched_subscriptions_.begin(), this->matched_subscriptions_.end());
+  for (uint16_t index : this->matched_subscriptions_) {
+    auto &subscription = this->subscriptions_[index];
+    if (subscription.view_callback) {
+      subscription.view_callback(StringRef(topic), StringRef(payload));
+    } else {
+      subscription.callback(topic, payload);
     }
-#ifdef USE_ESP8266
-  });
-#endif
+  }
 }
 
 // Setters
@@ -606,7 +680,10 @@ void MQTTClientComponent::set_log_level(int level) { this->log_level_ = level; }
 void MQTTClientComponent::set_keep_alive(uint16_t keep_alive_s) { this->mqtt_backend_.set_keep_alive(keep_alive_s); }
 void MQTTClientComponent::set_log_message_template(MQTTMessage &&message) { this->log_message_ = std::move(message); }
 const MQTTDiscoveryInfo &MQTTClientComponent::get_discovery_info() const { return this->discovery_info_; }
-void MQTTClientComponent::set_topic_prefix(const std::string &topic_prefix) { this->topic_prefix_ = topic_prefix; }
+void MQTTClientComponent::set_topic_prefix(const std::string &topic_prefix) {
+  this->topic_prefix_ = topic_prefix;
+  this->topic_prefix_version_++;
+}
 const std::string &MQTTClientComponent::get_topic_prefix() const { return this->topic_prefix_; }
 void MQTTClientComponent::disable_birth_message() {
   this->birth_message_.topic = "";
@@ -695,14 +772,14 @@ MQTTMessageTrigger::MQTTMessageTrigger(std::string topic) : topic_(std::move(top
 void MQTTMessageTrigger::set_qos(uint8_t qos) { this->qos_ = qos; }
 void MQTTMessageTrigger::set_payload(const std::string &payload) { this->payload_ = payload; }
 void MQTTMessageTrigger::setup() {
-  global_mqtt_client->subscribe(
+  global_mqtt_client->subscribe_view(
       this->topic_,
-      [this](const std::string &topic, const std::string &payload) {
+      [this](StringRef topic, StringRef payload) {
         if (this->payload_.has_value() && payload != *this->payload_) {
           return;
         }
 
-        this->trigger(payload);
+        this->trigger(payload.str());
       },
       this->qos_);
 }
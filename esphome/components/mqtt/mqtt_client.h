@@ -7,6 +7,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/log.h"
+#include "esphome/core/string_ref.h"
 #include "esphome/components/json/json_util.h"
 #include "esphome/components/network/ip_address.h"
 #if defined(USE_ESP32)
@@ -15,9 +16,16 @@
 #include "mqtt_backend_esp8266.h"
 #elif defined(USE_LIBRETINY)
 #include "mqtt_backend_libretiny.h"
+#elif defined(USE_HOST)
+#include "mqtt_backend_host.h"
 #endif
+#ifndef USE_HOST
 #include "lwip/ip_addr.h"
+#endif
+#include "mqtt_topic_trie.h"
 
+#include <deque>
+#include <map>
 #include <vector>
 
 namespace esphome {
@@ -34,12 +42,19 @@ using mqtt_on_disconnect_callback_t = std::function<MQTTBackend::on_disconnect_c
  */
 using mqtt_callback_t = std::function<void(const std::string &, const std::string &)>;
 using mqtt_json_callback_t = std::function<void(const std::string &, JsonObject)>;
+/** Callback for MQTT subscriptions receiving non-owning views of the message.
+ *
+ * First parameter is the topic, the second one is the payload. Both are only valid during the call and are always
+ * null-terminated.
+ */
+using mqtt_view_callback_t = std::function<void(StringRef, StringRef)>;
 
 /// internal struct for MQTT subscriptions.
 struct MQTTSubscription {
   std::string topic;
   uint8_t qos;
-  mqtt_callback_t callback;
+  mqtt_callback_t callback;  ///< Empty if view_callback is used.
+  mqtt_view_callback_t view_callback;
   bool subscribed;
   uint32_t resubscribe_timeout;
 };
@@ -168,6 +183,8 @@ class MQTTClientComponent : public Component {
   void set_topic_prefix(const std::string &topic_prefix);
   /// Get the topic prefix of this device, using default if necessary
   const std::string &get_topic_prefix() const;
+  /// Incremented every time the topic prefix changes, so cached topics can be invalidated.
+  uint16_t get_topic_prefix_version() const { return this->topic_prefix_version_; }
 
   /// Manually set the topic used for logging.
   void set_log_message_template(MQTTMessage &&message);
@@ -178,7 +195,7 @@ class MQTTClientComponent : public Component {
 
   /** Subscribe to an MQTT topic and call callback when a message is received.
    *
-   * @param topic The topic. Wildcards are currently not supported.
+   * @param topic The topic filter, may contain the `+` and `#` wildcards.
    * @param callback The callback function.
    * @param qos The QoS of this subscription.
    */
@@ -188,13 +205,23 @@ class MQTTClientComponent : public Component {
    *
    * If an invalid JSON payload is received, the callback will not be called.
    *
-   * @param topic The topic. Wildcards are currently not supported.
+   * @param topic The topic filter, may contain the `+` and `#` wildcards.
    * @param callback The callback with a parsed JsonObject that will be called when a message with matching topic is
    * received.
    * @param qos The QoS of this subscription.
    */
   void subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos = 0);
 
+  /** Subscribe to an MQTT topic and receive the messages as non-owning views.
+   *
+   * Avoids handing out std::string references for every matching subscription, see mqtt_view_callback_t.
+   *
+   * @param topic The topic filter, may contain the `+` and `#` wildcards.
+   * @param callback The callback function.
+   * @param qos The QoS of this subscription.
+   */
+  void subscribe_view(const std::string &topic, mqtt_view_callback_t callback, uint8_t qos = 0);
+
   /** Unsubscribe from an MQTT topic.
    *
    * If multiple existing subscriptions to the same topic exist, all of them will be removed.
@@ -218,6 +245,13 @@ class MQTTClientComponent : public Component {
    */
   bool publish(const std::string &topic, const std::string &payload, uint8_t qos = 0, bool retain = false);
 
+  /** Publish a MQTT message without copying the payload
+   *
+   * @param topic The topic.
+   * @param payload The payload, doesn't need to be null-terminated.
+   * @param payload_length The length of the payload.
+   * @param retain Whether to retain the message.
+   */
   bool publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos = 0,
                bool retain = false);
 
@@ -246,6 +280,12 @@ class MQTTClientComponent : public Component {
   void set_reboot_timeout(uint32_t reboot_timeout);
 
   void register_mqtt_component(MQTTComponent *component);
+  /** Queue the discovery message of a component.
+   *
+   * Discovery messages are serialized a few at a time and published from loop() when the outbound window of the
+   * backend has room, so that they don't hold back state and availability messages.
+   */
+  void queue_discovery(MQTTComponent *component);
 
   bool is_connected();
   void set_enable_on_boot(bool enable_on_boot) { this->enable_on_boot_ = enable_on_boot; }
@@ -272,7 +312,7 @@ class MQTTClientComponent : public Component {
   void check_dnslookup_();
 #if defined(USE_ESP8266) && LWIP_VERSION_MAJOR == 1
   static void dns_found_callback(const char *name, ip_addr_t *ipaddr, void *callback_arg);
-#else
+#elif !defined(USE_HOST)
   static void dns_found_callback(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
 #endif
 
@@ -280,9 +320,17 @@ class MQTTClientComponent : public Component {
   void recalculate_availability_();
 
   bool subscribe_(const char *topic, uint8_t qos);
+  void add_subscription_(MQTTSubscription &&subscription);
+  void dispatch_message_(const std::string &topic, const std::string &payload);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
 
+  /// Serialize queued discovery messages and publish the next one if the backend has room for it.
+  void process_discovery_queue_();
+  /// Subscribe to our own retained discovery messages, so that unchanged ones aren't sent again.
+  void subscribe_retained_discovery_();
+  void unsubscribe_retained_discovery_();
+
   MQTTCredentials credentials_;
   /// The last will message. Disabled optional denotes it being default and
   /// an empty topic denotes the the feature being disabled.
@@ -305,17 +353,39 @@ class MQTTClientComponent : public Component {
       .object_id_generator = MQTT_NONE_OBJECT_ID_GENERATOR,
   };
   std::string topic_prefix_{};
+  uint16_t topic_prefix_version_{1};
   MQTTMessage log_message_;
+  std::string topic_buffer_;
   std::string payload_buffer_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  /// Index of subscriptions_ by topic filter.
+  MQTTTopicTrie subscription_trie_;
+  /// Scratch space for the subscriptions matching a message.
+  std::vector<uint16_t> matched_subscriptions_;
+
+  struct QueuedDiscovery {
+    MQTTComponent *component;
+    MQTTMessage message;
+  };
+  /// Components whose discovery message hasn't been serialized yet.
+  std::deque<MQTTComponent *> discovery_pending_;
+  /// Serialized discovery messages waiting to be published.
+  std::deque<QueuedDiscovery> discovery_queue_;
+  /// FNV-1 hashes of the discovery payloads retained by the broker, by hash of their topic.
+  std::map<uint32_t, uint32_t> retained_discovery_;
+  /// Topic filter for our retained discovery messages, empty when not subscribed.
+  std::string retained_discovery_filter_;
+  uint32_t connected_at_{0};
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
   MQTTBackendESP8266 mqtt_backend_;
 #elif defined(USE_LIBRETINY)
   MQTTBackendLibreTiny mqtt_backend_;
+#elif defined(USE_HOST)
+  MQTTBackendHost mqtt_backend_;
 #endif
 
   MQTTClientState state_{MQTT_CLIENT_DISABLED};
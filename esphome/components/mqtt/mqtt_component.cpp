@@ -2,6 +2,7 @@
 
 #ifdef USE_MQTT
 
+#include <cinttypes>
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -36,16 +37,32 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
   return topic_prefix + "/" + this->component_type() + "/" + this->get_default_object_id_() + "/" + suffix;
 }
 
-std::string MQTTComponent::get_state_topic_() const {
-  if (this->has_custom_state_topic_)
-    return this->custom_state_topic_.str();
-  return this->get_default_topic_for_("state");
+const std::string &MQTTComponent::get_state_topic_() const {
+  this->update_topics_();
+  return this->state_topic_;
 }
 
-std::string MQTTComponent::get_command_topic_() const {
-  if (this->has_custom_command_topic_)
-    return this->custom_command_topic_.str();
-  return this->get_default_topic_for_("command");
+const std::string &MQTTComponent::get_command_topic_() const {
+  this->update_topics_();
+  return this->command_topic_;
+}
+
+void MQTTComponent::update_topics_() const {
+  uint16_t version = global_mqtt_client->get_topic_prefix_version();
+  if (this->topics_version_ == version)
+    return;
+  this->topics_version_ = version;
+
+  if (this->has_custom_state_topic_) {
+    this->state_topic_ = this->custom_state_topic_.str();
+  } else {
+    this->state_topic_ = this->get_default_topic_for_("state");
+  }
+  if (this->has_custom_command_topic_) {
+    this->command_topic_ = this->custom_command_topic_.str();
+  } else {
+    this->command_topic_ = this->get_default_topic_for_("command");
+  }
 }
 
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
@@ -54,144 +71,155 @@ bool MQTTComponent::publish(const std::string &topic, const std::string &payload
   return global_mqtt_client->publish(topic, payload, this->qos_, this->retain_);
 }
 
+bool MQTTComponent::publish(const std::string &topic, const char *payload, size_t payload_length) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish(topic, payload, payload_length, this->qos_, this->retain_);
+}
+
+bool MQTTComponent::publish(const std::string &topic, const char *payload) {
+  return this->publish(topic, payload, strlen(payload));
+}
+
 bool MQTTComponent::publish_json(const std::string &topic, const json::json_build_t &f) {
   if (topic.empty())
     return false;
   return global_mqtt_client->publish_json(topic, f, this->qos_, this->retain_);
 }
 
-bool MQTTComponent::send_discovery_() {
+void MQTTComponent::build_discovery_message(MQTTMessage &message) {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
+  message.topic = this->get_discovery_topic_(discovery_info);
+  message.qos = this->qos_;
 
   if (discovery_info.clean) {
     ESP_LOGV(TAG, "'%s': Cleaning discovery...", this->friendly_name().c_str());
-    return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, this->qos_, true);
+    message.payload.clear();
+    message.retain = true;
+    return;
   }
 
-  ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
-
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject root) {
-        SendDiscoveryConfig config;
-        config.state_topic = true;
-        config.command_topic = true;
-
-        this->send_discovery(root, config);
-        // Set subscription QoS (default is 0)
-        if (this->subscribe_qos_ != 0) {
-          root[MQTT_QOS] = this->subscribe_qos_;
-        }
-
-        // Fields from EntityBase
-        if (this->get_entity()->has_own_name()) {
-          root[MQTT_NAME] = this->friendly_name();
-        } else {
-          root[MQTT_NAME] = "";
-        }
-        if (this->is_disabled_by_default())
-          root[MQTT_ENABLED_BY_DEFAULT] = false;
-        if (!this->get_icon().empty())
-          root[MQTT_ICON] = this->get_icon();
-
-        switch (this->get_entity()->get_entity_category()) {
-          case ENTITY_CATEGORY_NONE:
-            break;
-          case ENTITY_CATEGORY_CONFIG:
-            root[MQTT_ENTITY_CATEGORY] = "config";
-            break;
-          case ENTITY_CATEGORY_DIAGNOSTIC:
-            root[MQTT_ENTITY_CATEGORY] = "diagnostic";
-            break;
-        }
-
-        if (config.state_topic)
-          root[MQTT_STATE_TOPIC] = this->get_state_topic_();
-        if (config.command_topic)
-          root[MQTT_COMMAND_TOPIC] = this->get_command_topic_();
-        if (this->command_retain_)
-          root[MQTT_COMMAND_RETAIN] = true;
-
-        if (this->availability_ == nullptr) {
-          if (!global_mqtt_client->get_availability().topic.empty()) {
-            root[MQTT_AVAILABILITY_TOPIC] = global_mqtt_client->get_availability().topic;
-            if (global_mqtt_client->get_availability().payload_available != "online")
-              root[MQTT_PAYLOAD_AVAILABLE] = global_mqtt_client->get_availability().payload_available;
-            if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root[MQTT_PAYLOAD_NOT_AVAILABLE] = global_mqtt_client->get_availability().payload_not_available;
-          }
-        } else if (!this->availability_->topic.empty()) {
-          root[MQTT_AVAILABILITY_TOPIC] = this->availability_->topic;
-          if (this->availability_->payload_available != "online")
-            root[MQTT_PAYLOAD_AVAILABLE] = this->availability_->payload_available;
-          if (this->availability_->payload_not_available != "offline")
-            root[MQTT_PAYLOAD_NOT_AVAILABLE] = this->availability_->payload_not_available;
-        }
-
-        std::string unique_id = this->unique_id();
-        const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
-        if (!unique_id.empty()) {
-          root[MQTT_UNIQUE_ID] = unique_id;
-        } else {
-          if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
-            char friendly_name_hash[9];
-            sprintf(friendly_name_hash, "%08" PRIx32, fnv1_hash(this->friendly_name()));
-            friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
-            root[MQTT_UNIQUE_ID] = get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash;
-          } else {
-            // default to almost-unique ID. It's a hack but the only way to get that
-            // gorgeous device registry view.
-            root[MQTT_UNIQUE_ID] = "ESP" + this->component_type() + this->get_default_object_id_();
-          }
-        }
-
-        const std::string &node_name = App.get_name();
-        if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
-          root[MQTT_OBJECT_ID] = node_name + "_" + this->get_default_object_id_();
-
-        std::string node_friendly_name = App.get_friendly_name();
-        if (node_friendly_name.empty()) {
-          node_friendly_name = node_name;
-        }
-        const std::string &node_area = App.get_area();
-
-        JsonObject device_info = root.createNestedObject(MQTT_DEVICE);
-        const auto mac = get_mac_address();
-        device_info[MQTT_DEVICE_IDENTIFIERS] = mac;
-        device_info[MQTT_DEVICE_NAME] = node_friendly_name;
+  ESP_LOGV(TAG, "'%s': Building discovery...", this->friendly_name().c_str());
+  message.retain = discovery_info.retain;
+  message.payload = json::build_json([this](JsonObject root) {
+    SendDiscoveryConfig config;
+    config.state_topic = true;
+    config.command_topic = true;
+
+    this->send_discovery(root, config);
+    // Set subscription QoS (default is 0)
+    if (this->subscribe_qos_ != 0) {
+      root[MQTT_QOS] = this->subscribe_qos_;
+    }
+
+    // Fields from EntityBase
+    if (this->get_entity()->has_own_name()) {
+      root[MQTT_NAME] = this->friendly_name();
+    } else {
+      root[MQTT_NAME] = "";
+    }
+    if (this->is_disabled_by_default())
+      root[MQTT_ENABLED_BY_DEFAULT] = false;
+    if (!this->get_icon().empty())
+      root[MQTT_ICON] = this->get_icon();
+
+    switch (this->get_entity()->get_entity_category()) {
+      case ENTITY_CATEGORY_NONE:
+        break;
+      case ENTITY_CATEGORY_CONFIG:
+        root[MQTT_ENTITY_CATEGORY] = "config";
+        break;
+      case ENTITY_CATEGORY_DIAGNOSTIC:
+        root[MQTT_ENTITY_CATEGORY] = "diagnostic";
+        break;
+    }
+
+    if (config.state_topic)
+      root[MQTT_STATE_TOPIC] = this->get_state_topic_();
+    if (config.command_topic)
+      root[MQTT_COMMAND_TOPIC] = this->get_command_topic_();
+    if (this->command_retain_)
+      root[MQTT_COMMAND_RETAIN] = true;
+
+    if (this->availability_ == nullptr) {
+      if (!global_mqtt_client->get_availability().topic.empty()) {
+        root[MQTT_AVAILABILITY_TOPIC] = global_mqtt_client->get_availability().topic;
+        if (global_mqtt_client->get_availability().payload_available != "online")
+          root[MQTT_PAYLOAD_AVAILABLE] = global_mqtt_client->get_availability().payload_available;
+        if (global_mqtt_client->get_availability().payload_not_available != "offline")
+          root[MQTT_PAYLOAD_NOT_AVAILABLE] = global_mqtt_client->get_availability().payload_not_available;
+      }
+    } else if (!this->availability_->topic.empty()) {
+      root[MQTT_AVAILABILITY_TOPIC] = this->availability_->topic;
+      if (this->availability_->payload_available != "online")
+        root[MQTT_PAYLOAD_AVAILABLE] = this->availability_->payload_available;
+      if (this->availability_->payload_not_available != "offline")
+        root[MQTT_PAYLOAD_NOT_AVAILABLE] = this->availability_->payload_not_available;
+    }
+
+    std::string unique_id = this->unique_id();
+    const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
+    if (!unique_id.empty()) {
+      root[MQTT_UNIQUE_ID] = unique_id;
+    } else {
+      if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
+        char friendly_name_hash[9];
+        sprintf(friendly_name_hash, "%08" PRIx32, fnv1_hash(this->friendly_name()));
+        friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
+        root[MQTT_UNIQUE_ID] = get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash;
+      } else {
+        // default to almost-unique ID. It's a hack but the only way to get that
+        // gorgeous device registry view.
+        root[MQTT_UNIQUE_ID] = "ESP" + this->component_type() + this->get_default_object_id_();
+      }
+    }
+
+    const std::string &node_name = App.get_name();
+    if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
+      root[MQTT_OBJECT_ID] = node_name + "_" + this->get_default_object_id_();
+
+    std::string node_friendly_name = App.get_friendly_name();
+    if (node_friendly_name.empty()) {
+      node_friendly_name = node_name;
+    }
+    const std::string &node_area = App.get_area();
+
+    JsonObject device_info = root.createNestedObject(MQTT_DEVICE);
+    const auto mac = get_mac_address();
+    device_info[MQTT_DEVICE_IDENTIFIERS] = mac;
+    device_info[MQTT_DEVICE_NAME] = node_friendly_name;
 #ifdef ESPHOME_PROJECT_NAME
-        device_info[MQTT_DEVICE_SW_VERSION] = ESPHOME_PROJECT_VERSION " (ESPHome " ESPHOME_VERSION ")";
-        const char *model = std::strchr(ESPHOME_PROJECT_NAME, '.');
-        if (model == nullptr) {  // must never happen but check anyway
-          device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
-          device_info[MQTT_DEVICE_MANUFACTURER] = ESPHOME_PROJECT_NAME;
-        } else {
-          device_info[MQTT_DEVICE_MODEL] = model + 1;
-          device_info[MQTT_DEVICE_MANUFACTURER] = std::string(ESPHOME_PROJECT_NAME, model - ESPHOME_PROJECT_NAME);
-        }
+    device_info[MQTT_DEVICE_SW_VERSION] = ESPHOME_PROJECT_VERSION " (ESPHome " ESPHOME_VERSION ")";
+    const char *model = std::strchr(ESPHOME_PROJECT_NAME, '.');
+    if (model == nullptr) {  // must never happen but check anyway
+      device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
+      device_info[MQTT_DEVICE_MANUFACTURER] = ESPHOME_PROJECT_NAME;
+    } else {
+      device_info[MQTT_DEVICE_MODEL] = model + 1;
+      device_info[MQTT_DEVICE_MANUFACTURER] = std::string(ESPHOME_PROJECT_NAME, model - ESPHOME_PROJECT_NAME);
+    }
 #else
-        device_info[MQTT_DEVICE_SW_VERSION] = ESPHOME_VERSION " (" + App.get_compilation_time() + ")";
-        device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
+    device_info[MQTT_DEVICE_SW_VERSION] = ESPHOME_VERSION " (" + App.get_compilation_time() + ")";
+    device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
 #if defined(USE_ESP8266) || defined(USE_ESP32)
-        device_info[MQTT_DEVICE_MANUFACTURER] = "Espressif";
+    device_info[MQTT_DEVICE_MANUFACTURER] = "Espressif";
 #elif defined(USE_RP2040)
-        device_info[MQTT_DEVICE_MANUFACTURER] = "Raspberry Pi";
+    device_info[MQTT_DEVICE_MANUFACTURER] = "Raspberry Pi";
 #elif defined(USE_BK72XX)
-        device_info[MQTT_DEVICE_MANUFACTURER] = "Beken";
+    device_info[MQTT_DEVICE_MANUFACTURER] = "Beken";
 #elif defined(USE_RTL87XX)
-        device_info[MQTT_DEVICE_MANUFACTURER] = "Realtek";
+    device_info[MQTT_DEVICE_MANUFACTURER] = "Realtek";
 #elif defined(USE_HOST)
-        device_info[MQTT_DEVICE_MANUFACTURER] = "Host";
+    device_info[MQTT_DEVICE_MANUFACTURER] = "Host";
 #endif
 #endif
-        if (!node_area.empty()) {
-          device_info[MQTT_DEVICE_SUGGESTED_AREA] = node_area;
-        }
-
-        device_info[MQTT_DEVICE_CONNECTIONS][0][0] = "mac";
-        device_info[MQTT_DEVICE_CONNECTIONS][0][1] = mac;
-      },
-      this->qos_, discovery_info.retain);
+    if (!node_area.empty()) {
+      device_info[MQTT_DEVICE_SUGGESTED_AREA] = node_area;
+    }
+
+    device_info[MQTT_DEVICE_CONNECTIONS][0][0] = "mac";
+    device_info[MQTT_DEVICE_CONNECTIONS][0][1] = mac;
+  });
 }
 
 uint8_t MQTTComponent::get_qos() const { return this->qos_; }
@@ -214,6 +242,10 @@ void MQTTComponent::subscribe_json(const std::string &topic, const mqtt_json_cal
   global_mqtt_client->subscribe_json(topic, callback, qos);
 }
 
+void MQTTComponent::subscribe_view(const std::string &topic, mqtt_view_callback_t callback, uint8_t qos) {
+  global_mqtt_client->subscribe_view(topic, std::move(callback), qos);
+}
+
 MQTTComponent::MQTTComponent() = default;
 
 float MQTTComponent::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
@@ -221,10 +253,12 @@ void MQTTComponent::disable_discovery() { this->discovery_enabled_ = false; }
 void MQTTComponent::set_custom_state_topic(const char *custom_state_topic) {
   this->custom_state_topic_ = StringRef(custom_state_topic);
   this->has_custom_state_topic_ = true;
+  this->topics_version_ = 0;
 }
 void MQTTComponent::set_custom_command_topic(const char *custom_command_topic) {
   this->custom_command_topic_ = StringRef(custom_command_topic);
   this->has_custom_command_topic_ = true;
+  this->topics_version_ = 0;
 }
 void MQTTComponent::set_command_retain(bool command_retain) { this->command_retain_ = command_retain; }
 
@@ -247,14 +281,7 @@ void MQTTComponent::call_setup() {
   if (!this->is_connected_())
     return;
 
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
-  }
-  if (!this->send_initial_state()) {
-    this->schedule_resend_state();
-  }
+  this->send_discovery_and_state_();
 }
 
 void MQTTComponent::call_loop() {
@@ -268,10 +295,15 @@ void MQTTComponent::call_loop() {
   }
 
   this->resend_state_ = false;
+  this->send_discovery_and_state_();
+}
+void MQTTComponent::send_discovery_and_state_() {
   if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
+    global_mqtt_client->queue_discovery(this);
+    // Home Assistant only sees states that aren't retained if they arrive after the discovery message, so the client
+    // sends those once the discovery message is out.
+    if (!this->retain_)
+      return;
   }
   if (!this->send_initial_state()) {
     this->schedule_resend_state();
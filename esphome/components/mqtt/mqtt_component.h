@@ -115,6 +115,9 @@ class MQTTComponent : public Component {
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
 
+  /// Internal method for the MQTT client base to serialize the discovery message, this will call send_discovery().
+  void build_discovery_message(MQTTMessage &message);
+
   /** Send a MQTT message.
    *
    * @param topic The topic.
@@ -122,6 +125,21 @@ class MQTTComponent : public Component {
    */
   bool publish(const std::string &topic, const std::string &payload);
 
+  /** Send a MQTT message without copying the payload.
+   *
+   * @param topic The topic.
+   * @param payload The payload, doesn't need to be null-terminated.
+   * @param payload_length The length of the payload.
+   */
+  bool publish(const std::string &topic, const char *payload, size_t payload_length);
+
+  /** Send a MQTT message with a null-terminated payload, for example one formatted into a stack buffer.
+   *
+   * @param topic The topic.
+   * @param payload The payload.
+   */
+  bool publish(const std::string &topic, const char *payload);
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -148,6 +166,14 @@ class MQTTComponent : public Component {
    */
   void subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos = 0);
 
+  /** Subscribe to a MQTT topic and receive the messages as non-owning views.
+   *
+   * @param topic The topic.
+   * @param callback The callback that will be called when a message with matching topic is received.
+   * @param qos The MQTT quality of service. Defaults to 0.
+   */
+  void subscribe_view(const std::string &topic, mqtt_view_callback_t callback, uint8_t qos = 0);
+
  protected:
   /// Helper method to get the discovery topic for this component.
   std::string get_discovery_topic_(const MQTTDiscoveryInfo &discovery_info) const;
@@ -180,16 +206,19 @@ class MQTTComponent : public Component {
   /// Get whether the underlying Entity is disabled by default
   virtual bool is_disabled_by_default() const;
 
-  /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  /// Get the MQTT topic that new states will be shared to, cached after the first call.
+  const std::string &get_state_topic_() const;
 
-  /// Get the MQTT topic for listening to commands.
-  std::string get_command_topic_() const;
+  /// Get the MQTT topic for listening to commands, cached after the first call.
+  const std::string &get_command_topic_() const;
+
+  /// Recalculate the cached state and command topics if the topic prefix has changed.
+  void update_topics_() const;
 
   bool is_connected_() const;
 
-  /// Internal method to start sending discovery info, this will call send_discovery().
-  bool send_discovery_();
+  /// Queue the discovery message with the client and send the initial state.
+  void send_discovery_and_state_();
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -199,6 +228,11 @@ class MQTTComponent : public Component {
   StringRef custom_state_topic_{};
   StringRef custom_command_topic_{};
 
+  mutable std::string state_topic_{};
+  mutable std::string command_topic_{};
+  /// Topic prefix version the cached topics were calculated for, 0 if they are invalid.
+  mutable uint16_t topics_version_{0};
+
   std::unique_ptr<Availability> availability_;
 
   bool has_custom_state_topic_{false};
@@ -69,8 +69,8 @@ bool MQTTNumberComponent::send_initial_state() {
 }
 bool MQTTNumberComponent::publish_state(float value) {
   char buffer[64];
-  snprintf(buffer, sizeof(buffer), "%f", value);
-  return this->publish(this->get_state_topic_(), buffer);
+  int len = snprintf(buffer, sizeof(buffer), "%f", value);
+  return this->publish(this->get_state_topic_(), buffer, std::min<size_t>(len, sizeof(buffer) - 1));
 }
 
 }  // namespace mqtt
@@ -0,0 +1,99 @@
+#include "mqtt_topic_trie.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstring>
+#include "esphome/core/helpers.h"
+
+namespace esphome {
+namespace mqtt {
+
+void MQTTTopicTrie::insert(const std::string &filter, uint16_t index) {
+  Node *node = &this->root_;
+  size_t start = 0;
+  while (true) {
+    size_t end = filter.find('/', start);
+    size_t len = (end == std::string::npos ? filter.size() : end) - start;
+    if (len == 1 && filter[start] == '#') {
+      // multi-level wildcard - MQTT mandates that this must be at end of the filter
+      node->multi_level.push_back(index);
+      return;
+    }
+    if (len == 1 && filter[start] == '+') {
+      if (!node->single_level)
+        node->single_level = make_unique<Node>();
+      node = node->single_level.get();
+    } else {
+      auto it = std::lower_bound(node->children.begin(), node->children.end(), filter.c_str() + start,
+                                 [len](const Node &child, const char *key) {
+                                   return child.level.compare(0, std::string::npos, key, len) < 0;
+                                 });
+      if (it == node->children.end() || it->level.compare(0, std::string::npos, filter, start, len) != 0) {
+        Node child;
+        child.level = filter.substr(start, len);
+        it = node->children.insert(it, std::move(child));
+      }
+      node = &*it;
+    }
+    if (end == std::string::npos) {
+      node->subscriptions.push_back(index);
+      return;
+    }
+    start = end + 1;
+  }
+}
+
+void MQTTTopicTrie::clear() { this->root_ = Node{}; }
+
+void MQTTTopicTrie::match(const char *topic, std::vector<uint16_t> &out) const {
+  match_(this->root_, topic, true, out);
+}
+
+void MQTTTopicTrie::match_(const Node &node, const char *level, bool first_level, std::vector<uint16_t> &out) {
+  const char *end = strchr(level, '/');
+  size_t len = end == nullptr ? strlen(level) : end - level;
+  // Wildcards at the first level must not match topics like "$SYS/..."
+  bool wildcards = !first_level || *level != '$';
+
+  if (wildcards)
+    out.insert(out.end(), node.multi_level.begin(), node.multi_level.end());
+
+  const Node *child = find_child_(node, level, len);
+  if (child != nullptr) {
+    if (end == nullptr) {
+      match_end_(*child, out);
+    } else {
+      match_(*child, end + 1, false, out);
+    }
+  }
+
+  if (wildcards && node.single_level) {
+    if (end == nullptr) {
+      match_end_(*node.single_level, out);
+    } else {
+      match_(*node.single_level, end + 1, false, out);
+    }
+  }
+}
+
+const MQTTTopicTrie::Node *MQTTTopicTrie::find_child_(const Node &node, const char *level, size_t len) {
+  auto it = std::lower_bound(node.children.begin(), node.children.end(), level,
+                             [len](const Node &child, const char *key) {
+                               return child.level.compare(0, std::string::npos, key, len) < 0;
+                             });
+  if (it == node.children.end() || it->level.compare(0, std::string::npos, level, len) != 0)
+    return nullptr;
+  return &*it;
+}
+
+void MQTTTopicTrie::match_end_(const Node &node, std::vector<uint16_t> &out) {
+  out.insert(out.end(), node.subscriptions.begin(), node.subscriptions.end());
+  // "a/#" also matches "a"
+  out.insert(out.end(), node.multi_level.begin(), node.multi_level.end());
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
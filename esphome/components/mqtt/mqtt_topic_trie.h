@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Trie of MQTT topic filters, one node per topic level.
+ *
+ * Used to find the subscriptions matching an incoming message in O(topic levels) instead of matching the topic
+ * against every subscription. Literal levels are looked up with a binary search, the `+` and `#` wildcards have
+ * their own slots in each node. Subscriptions are identified by their index in the subscription list of the client.
+ */
+class MQTTTopicTrie {
+ public:
+  /// Add a topic filter, which may contain the `+` and `#` wildcards.
+  void insert(const std::string &filter, uint16_t index);
+  /// Remove all topic filters.
+  void clear();
+  /** Append the indices of all subscriptions whose filter matches the topic to out, in no particular order.
+   *
+   * Wildcards at the first level don't match topics starting with `$` and a trailing `#` also matches the parent
+   * level, as mandated by the MQTT specification.
+   */
+  void match(const char *topic, std::vector<uint16_t> &out) const;
+
+ protected:
+  struct Node {
+    std::string level;
+    /// Children for literal levels, sorted by level.
+    std::vector<Node> children;
+    /// Child for the `+` single-level wildcard.
+    std::unique_ptr<Node> single_level;
+    /// Subscriptions whose filter ends with a `#` after this level.
+    std::vector<uint16_t> multi_level;
+    /// Subscriptions whose filter ends at this level.
+    std::vector<uint16_t> subscriptions;
+  };
+
+  static const Node *find_child_(const Node &node, const char *level, size_t len);
+  static void match_(const Node &node, const char *level, bool first_level, std::vector<uint16_t> &out);
+  static void match_end_(const Node &node, std::vector<uint16_t> &out);
+
+  Node root_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -49,6 +49,12 @@ struct IPAddress {
   }
   IPAddress(const std::string &in_address) { inet_aton(in_address.c_str(), &ip_addr_); }
   IPAddress(const ip_addr_t *other_ip) { ip_addr_ = *other_ip; }
+  bool is_set() { return ip_addr_.s_addr != 0; }
+  std::string str() const {
+    char buf[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &ip_addr_, buf, sizeof(buf));
+    return buf;
+  }
 #else
   IPAddress() { ip_addr_set_zero(&ip_addr_); }
   IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) {
@@ -12,6 +12,7 @@ from esphome.components.image import (
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_BUFFER_SIZE,
+    CONF_DITHER,
     CONF_FORMAT,
     CONF_ID,
     CONF_ON_ERROR,
@@ -28,6 +29,7 @@ MULTI_CONF = True
 
 CONF_ON_DOWNLOAD_FINISHED = "on_download_finished"
 CONF_PLACEHOLDER = "placeholder"
+CONF_PROGRESSIVE = "progressive"
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -69,6 +71,9 @@ ONLINE_IMAGE_SCHEMA = cv.Schema(
         # Not setting default here on purpose; the default depends on the image type,
         # and thus will be set in the "validate_cross_dependencies" validator.
         cv.Optional(CONF_USE_TRANSPARENCY): cv.boolean,
+        cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
+            "NONE", "FLOYDSTEINBERG", upper=True
+        ),
         #
         # Online Image specific options
         #
@@ -76,6 +81,7 @@ ONLINE_IMAGE_SCHEMA = cv.Schema(
         cv.Required(CONF_FORMAT): cv.enum(IMAGE_FORMAT, upper=True),
         cv.Optional(CONF_PLACEHOLDER): cv.use_id(Image_),
         cv.Optional(CONF_BUFFER_SIZE, default=2048): cv.int_range(256, 65536),
+        cv.Optional(CONF_PROGRESSIVE, default=False): cv.boolean,
         cv.Optional(CONF_ON_DOWNLOAD_FINISHED): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(DownloadFinishedTrigger),
@@ -154,6 +160,10 @@ async def to_code(config):
     await cg.register_parented(var, config[CONF_HTTP_REQUEST_ID])
 
     cg.add(var.set_transparency(transparent))
+    if config[CONF_DITHER] != "NONE":
+        cg.add(var.set_dither(True))
+    if config[CONF_PROGRESSIVE]:
+        cg.add(var.set_progressive(True))
 
     if placeholder_id := config.get(CONF_PLACEHOLDER):
         placeholder = await cg.get_variable(placeholder_id)
@@ -1,8 +1,11 @@
 #include "image_decoder.h"
 #include "online_image.h"
 
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace online_image {
 
@@ -12,6 +15,29 @@ void ImageDecoder::set_size(int width, int height) {
   this->image_->resize_(width, height);
   this->x_scale_ = static_cast<double>(this->image_->buffer_width_) / width;
   this->y_scale_ = static_cast<double>(this->image_->buffer_height_) / height;
+
+  this->source_width_ = width;
+  this->source_height_ = height;
+  this->source_x_ = 0;
+  this->source_y_ = 0;
+  this->row_ = 0;
+  // Rows can only be averaged if every pixel of the image gets at least one source pixel.
+  this->streaming_ = this->image_->buffer_ != nullptr && this->x_scale_ <= 1.0 && this->y_scale_ <= 1.0;
+  if (!this->streaming_)
+    return;
+  int image_width = this->image_->buffer_width_;
+  this->weighted_ = this->image_->has_transparency();
+  this->row_sums_.assign(image_width * 4, 0);
+  this->row_counts_.assign(image_width, 0);
+  auto type = this->image_->get_type();
+  if (this->image_->dither_ &&
+      (type == image::IMAGE_TYPE_RGB565 || (type == image::IMAGE_TYPE_BINARY && !this->image_->has_transparency()))) {
+    this->dither_row_.assign((image_width + 2) * 3, 0);
+    this->dither_next_row_.assign((image_width + 2) * 3, 0);
+  } else {
+    this->dither_row_.clear();
+    this->dither_next_row_.clear();
+  }
 }
 
 void ImageDecoder::draw(int x, int y, int w, int h, const Color &color) {
@@ -24,6 +50,96 @@ void ImageDecoder::draw(int x, int y, int w, int h, const Color &color) {
   }
 }
 
+void HOT ImageDecoder::draw_pixel(int x, int y, const Color &color) {
+  if (!this->streaming_ || x != this->source_x_ || y != this->source_y_) {
+    this->stop_streaming_();
+    this->draw(x, y, 1, 1, color);
+    return;
+  }
+  int column = x * this->image_->buffer_width_ / this->source_width_;
+  uint32_t weight = this->weighted_ ? color.w : 1;
+  uint32_t *sums = &this->row_sums_[column * 4];
+  sums[0] += color.r * weight;
+  sums[1] += color.g * weight;
+  sums[2] += color.b * weight;
+  sums[3] += color.w;
+  this->row_counts_[column]++;
+
+  if (++this->source_x_ < this->source_width_)
+    return;
+  this->source_x_ = 0;
+  this->source_y_++;
+  if (this->source_y_ * this->image_->buffer_height_ / this->source_height_ != this->row_)
+    this->flush_row_();
+}
+
+void ImageDecoder::flush_row_() {
+  int image_width = this->image_->buffer_width_;
+  bool dither = !this->dither_row_.empty();
+  for (int x = 0; x < image_width; x++) {
+    uint32_t count = this->row_counts_[x];
+    if (count == 0)
+      continue;
+    const uint32_t *sums = &this->row_sums_[x * 4];
+    uint32_t weight = this->weighted_ ? sums[3] : count;
+    Color color;
+    if (weight != 0)
+      color = Color(sums[0] / weight, sums[1] / weight, sums[2] / weight, sums[3] / count);
+    if (dither)
+      color = this->dither_(x, color);
+    this->image_->draw_pixel_(x, this->row_, color);
+  }
+  std::fill(this->row_sums_.begin(), this->row_sums_.end(), 0);
+  std::fill(this->row_counts_.begin(), this->row_counts_.end(), 0);
+  if (dither) {
+    this->dither_row_.swap(this->dither_next_row_);
+    std::fill(this->dither_next_row_.begin(), this->dither_next_row_.end(), 0);
+  }
+  this->row_++;
+  this->image_->rows_decoded_(this->row_);
+}
+
+void ImageDecoder::stop_streaming_() {
+  if (!this->streaming_)
+    return;
+  this->streaming_ = false;
+  if (std::any_of(this->row_counts_.begin(), this->row_counts_.end(), [](uint32_t count) { return count != 0; }))
+    this->flush_row_();
+}
+
+/// Diffuse the quantization error of a channel to the neighbouring pixels, with the Floyd-Steinberg weights.
+static inline void diffuse_error(int16_t *row, int16_t *next_row, int error) {
+  row[3] += error * 7 / 16;
+  next_row[-3] += error * 3 / 16;
+  next_row[0] += error * 5 / 16;
+  next_row[3] += error / 16;
+}
+
+Color ImageDecoder::dither_(int x, Color color) {
+  int16_t *row = &this->dither_row_[(x + 1) * 3];
+  int16_t *next_row = &this->dither_next_row_[(x + 1) * 3];
+  if (this->image_->get_type() == image::IMAGE_TYPE_BINARY) {
+    // Same luminance approximation as the conversion to binary.
+    int value = clamp((color.r >> 2) + (color.g >> 1) + (color.b >> 2) + row[0], 0, 255);
+    uint8_t level = value < 128 ? 0 : 255;
+    diffuse_error(row, next_row, value - level);
+    return Color(level, level, level, color.w);
+  }
+  // RGB565
+  static const uint8_t BITS[3] = {5, 6, 5};
+  uint8_t *channels[3] = {&color.r, &color.g, &color.b};
+  for (int c = 0; c < 3; c++) {
+    int value = clamp(*channels[c] + row[c], 0, 255);
+    int shift = 8 - BITS[c];
+    int quantized = value >> shift;
+    // The value that the quantized one is expanded to again when drawn.
+    uint8_t level = (quantized << shift) | (quantized >> (BITS[c] - shift));
+    diffuse_error(row + c, next_row + c, value - level);
+    *channels[c] = level;
+  }
+  return color;
+}
+
 uint8_t *DownloadBuffer::data(size_t offset) {
   if (offset > this->size_) {
     ESP_LOGE(TAG, "Tried to access beyond download buffer bounds!!!");
@@ -2,6 +2,8 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/color.h"
 
+#include <vector>
+
 namespace esphome {
 namespace online_image {
 
@@ -63,6 +65,19 @@ class ImageDecoder {
    */
   void draw(int x, int y, int w, int h, const Color &color);
 
+  /**
+   * @brief Draw the next pixel of the image, for decoders that produce the pixels row by row, from left to right.
+   * The source rows are averaged into the rows of the resized image, which are dithered if requested and stored as
+   * soon as they are complete, so that no more than one row is buffered. If the pixels come in any other order, or
+   * the image is scaled up, this falls back to draw() for the rest of the image.
+   * Called by the callback functions, to be able to access the parent Image class.
+   *
+   * @param x The horizontal coordinate of the pixel.
+   * @param y The vertical coordinate of the pixel.
+   * @param color The color of the pixel.
+   */
+  void draw_pixel(int x, int y, const Color &color);
+
   bool is_finished() const { return this->decoded_bytes_ == this->download_size_; }
 
  protected:
@@ -73,6 +88,30 @@ class ImageDecoder {
   uint32_t decoded_bytes_ = 0;
   double x_scale_ = 1.0;
   double y_scale_ = 1.0;
+
+  /// Store the averaged pixels of the current row of the image, and start the next one.
+  void flush_row_();
+  /// Stop averaging rows, storing the pixels received so far.
+  void stop_streaming_();
+  /// Apply Floyd-Steinberg dithering for the storage format of the image to a pixel of the current row.
+  Color dither_(int x, Color color);
+
+  bool streaming_ = false;
+  /// Whether colors are weighted by their alpha when averaged, so that transparent pixels don't darken the edges.
+  bool weighted_ = false;
+  int source_width_ = 0;
+  int source_height_ = 0;
+  /// Position of the next pixel when decoding row by row.
+  int source_x_ = 0;
+  int source_y_ = 0;
+  /// Row of the image that the current source rows are averaged into.
+  int row_ = 0;
+  /// Per column of the image: the sums of the (weighted) red, green and blue values and of the alpha values.
+  std::vector<uint32_t> row_sums_;
+  std::vector<uint32_t> row_counts_;
+  /// Dithering errors of the current and the next row, 3 channels per column with one column of margin on each side.
+  std::vector<int16_t> dither_row_;
+  std::vector<int16_t> dither_next_row_;
 };
 
 class DownloadBuffer {
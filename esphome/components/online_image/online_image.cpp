@@ -248,6 +248,14 @@ void OnlineImage::draw_pixel_(int x, int y, Color color) {
   }
 }
 
+void OnlineImage::rows_decoded_(int rows) {
+  if (!this->progressive_)
+    return;
+  this->data_start_ = this->buffer_;
+  this->width_ = this->buffer_width_;
+  this->height_ = rows;
+}
+
 void OnlineImage::end_connection_() {
   if (this->downloader_) {
     this->downloader_->end();
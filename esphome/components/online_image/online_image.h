@@ -70,6 +70,15 @@ class OnlineImage : public PollingComponent,
    */
   void set_placeholder(image::Image *placeholder) { this->placeholder_ = placeholder; }
 
+  /// Apply Floyd-Steinberg dithering when storing the image as BINARY or RGB565.
+  void set_dither(bool dither) { this->dither_ = dither; }
+
+  /**
+   * @brief Show the rows of the image as soon as they are decoded, instead of only once the whole image is.
+   * Only supported for images decoded row by row (e.g. non-interlaced PNG); other images are shown when complete.
+   */
+  void set_progressive(bool progressive) { this->progressive_ = progressive; }
+
   /**
    * Release the buffer storing the image. The image will need to be downloaded again
    * to be able to be displayed.
@@ -107,6 +116,13 @@ class OnlineImage : public PollingComponent,
    */
   void draw_pixel_(int x, int y, Color color);
 
+  /**
+   * @brief Called by the decoder when the first rows of the buffer are complete.
+   *
+   * @param rows The number of complete rows.
+   */
+  void rows_decoded_(int rows);
+
   void end_connection_();
 
   CallbackManager<void()> download_finished_callback_{};
@@ -123,6 +139,9 @@ class OnlineImage : public PollingComponent,
 
   std::string url_{""};
 
+  bool dither_{false};
+  bool progressive_{false};
+
   /** width requested on configuration, or 0 if non specified. */
   const int fixed_width_;
   /** height requested on configuration, or 0 if non specified. */
@@ -133,7 +152,7 @@ class OnlineImage : public PollingComponent,
    * starts and the original size is known.
    * This needs to be separate from "BaseImage::get_width()" because the latter
    * must return 0 until the image has been decoded (to avoid showing partially
-   * decoded images).
+   * decoded images, unless progressive display is enabled).
    */
   int buffer_width_;
   /**
@@ -142,12 +161,11 @@ class OnlineImage : public PollingComponent,
    * starts and the original size is known.
    * This needs to be separate from "BaseImage::get_height()" because the latter
    * must return 0 until the image has been decoded (to avoid showing partially
-   * decoded images).
+   * decoded images, unless progressive display is enabled).
    */
   int buffer_height_;
 
-  friend void ImageDecoder::set_size(int width, int height);
-  friend void ImageDecoder::draw(int x, int y, int w, int h, const Color &color);
+  friend class ImageDecoder;
 };
 
 template<typename... Ts> class OnlineImageSetUrlAction : public Action<Ts...> {
@@ -38,7 +38,12 @@ static void init_callback(pngle_t *pngle, uint32_t w, uint32_t h) {
 static void draw_callback(pngle_t *pngle, uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint8_t rgba[4]) {
   PngDecoder *decoder = (PngDecoder *) pngle_get_user_data(pngle);
   Color color(rgba[0], rgba[1], rgba[2], rgba[3]);
-  decoder->draw(x, y, w, h, color);
+  if (w == 1 && h == 1) {
+    // Non-interlaced images are decoded pixel by pixel, in row order.
+    decoder->draw_pixel(x, y, color);
+  } else {
+    decoder->draw(x, y, w, h, color);
+  }
 }
 
 void PngDecoder::prepare(uint32_t download_size) {
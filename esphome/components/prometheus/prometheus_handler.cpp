@@ -1,65 +1,160 @@
 #include "prometheus_handler.h"
 #ifdef USE_NETWORK
 #include "esphome/core/application.h"
+#include <algorithm>
+#include <cstring>
 
 namespace esphome {
 namespace prometheus {
 
+static void append_value(std::string &out, float value, int8_t accuracy_decimals) {
+  char buf[32];
+  int len = value_accuracy_to_buf(buf, sizeof(buf), value, accuracy_decimals);
+  out.append(buf, std::min<size_t>(len, sizeof(buf) - 1));
+}
+
+/// Floats without a known accuracy are rendered with 2 decimals, as Print::print() did before.
+static void append_value(std::string &out, float value) { append_value(out, value, 2); }
+
+static void append_value(std::string &out, int value) {
+  char buf[12];
+  int len = snprintf(buf, sizeof(buf), "%d", value);
+  out.append(buf, len);
+}
+
+void PrometheusHandler::setup() {
+  this->base_->init();
+  this->base_->add_handler(this);
+
+  // Entities are all registered by now, so their labels can be built before the first scrape.
+#ifdef USE_SENSOR
+  for (auto *obj : App.get_sensors())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_BINARY_SENSOR
+  for (auto *obj : App.get_binary_sensors())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_FAN
+  for (auto *obj : App.get_fans())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_LIGHT
+  for (auto *obj : App.get_lights())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_COVER
+  for (auto *obj : App.get_covers())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_SWITCH
+  for (auto *obj : App.get_switches())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : App.get_locks())
+    this->label_prefix_(obj);
+#endif
+#ifdef USE_TEXT_SENSOR
+  for (auto *obj : App.get_text_sensors())
+    this->label_prefix_(obj);
+#endif
+
+  if (this->cache_)
+    this->setup_controller(this->include_internal_);
+}
+
 void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
-  std::string area = App.get_area();
-  std::string node = App.get_name();
-  std::string friendly_name = App.get_friendly_name();
+  if (!this->is_cache_valid_()) {
+    // A scrape that is still being sent by an earlier response can't be overwritten.
+    if (this->scrape_ == nullptr || this->scrape_.use_count() > 1) {
+      this->scrape_ = std::make_shared<std::string>();
+      this->scrape_->reserve(this->scrape_size_);
+    } else {
+      this->scrape_->clear();
+    }
+    // Taken before rendering, so that changes while rendering invalidate the scrape.
+    this->scrape_version_ = this->state_version_;
+    this->render_(*this->scrape_);
+    this->scrape_size_ = this->scrape_->size();
+  }
+
+  std::shared_ptr<std::string> scrape = this->scrape_;
+  if (!this->cache_)
+    this->scrape_.reset();
+  req->send(req->beginChunkedResponse("text/plain; version=0.0.4; charset=utf-8",
+                                      [scrape](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+                                        if (index >= scrape->size())
+                                          return 0;
+                                        size_t len = std::min(max_len, scrape->size() - index);
+                                        memcpy(buffer, scrape->data() + index, len);
+                                        return len;
+                                      }));
+}
+
+bool PrometheusHandler::is_cache_valid_() {
+  if (!this->cache_ || this->scrape_ == nullptr || this->scrape_version_ != this->state_version_)
+    return false;
+#ifdef USE_LIGHT
+  // Transitions and effects change the current values of a light without calling its callbacks.
+  for (auto *obj : App.get_lights()) {
+    if (obj->is_internal() && !this->include_internal_)
+      continue;
+    if (obj->is_transformer_active() || obj->get_effect_name() != "None")
+      return false;
+  }
+#endif
+  return true;
+}
 
+void PrometheusHandler::render_(std::string &out) {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
+  this->sensor_type_(out);
   for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj, area, node, friendly_name);
+    this->sensor_row_(out, obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
+  this->binary_sensor_type_(out);
   for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj, area, node, friendly_name);
+    this->binary_sensor_row_(out, obj);
 #endif
 
 #ifdef USE_FAN
-  this->fan_type_(stream);
+  this->fan_type_(out);
   for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj, area, node, friendly_name);
+    this->fan_row_(out, obj);
 #endif
 
 #ifdef USE_LIGHT
-  this->light_type_(stream);
+  this->light_type_(out);
   for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj, area, node, friendly_name);
+    this->light_row_(out, obj);
 #endif
 
 #ifdef USE_COVER
-  this->cover_type_(stream);
+  this->cover_type_(out);
   for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj, area, node, friendly_name);
+    this->cover_row_(out, obj);
 #endif
 
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
+  this->switch_type_(out);
   for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj, area, node, friendly_name);
+    this->switch_row_(out, obj);
 #endif
 
 #ifdef USE_LOCK
-  this->lock_type_(stream);
+  this->lock_type_(out);
   for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj, area, node, friendly_name);
+    this->lock_row_(out, obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  this->text_sensor_type_(stream);
+  this->text_sensor_type_(out);
   for (auto *obj : App.get_text_sensors())
-    this->text_sensor_row_(stream, obj, area, node, friendly_name);
+    this->text_sensor_row_(out, obj);
 #endif
-
-  req->send(stream);
 }
 
 std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
@@ -72,441 +167,265 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
-void PrometheusHandler::add_area_label_(AsyncResponseStream *stream, std::string &area) {
-  if (!area.empty()) {
-    stream->print(F("\",area=\""));
-    stream->print(area.c_str());
-  }
-}
+const std::string &PrometheusHandler::label_prefix_(EntityBase *obj) {
+  auto item = this->label_prefixes_.find(obj);
+  if (item != this->label_prefixes_.end())
+    return item->second;
 
-void PrometheusHandler::add_node_label_(AsyncResponseStream *stream, std::string &node) {
-  if (!node.empty()) {
-    stream->print(F("\",node=\""));
-    stream->print(node.c_str());
+  std::string labels = "id=\"";
+  labels += this->relabel_id_(obj);
+  if (!App.get_area().empty()) {
+    labels += "\",area=\"";
+    labels += App.get_area();
   }
+  if (!App.get_name().empty()) {
+    labels += "\",node=\"";
+    labels += App.get_name();
+  }
+  if (!App.get_friendly_name().empty()) {
+    labels += "\",friendly_name=\"";
+    labels += App.get_friendly_name();
+  }
+  labels += "\",name=\"";
+  labels += this->relabel_name_(obj);
+  return this->label_prefixes_.emplace(obj, std::move(labels)).first->second;
 }
 
-void PrometheusHandler::add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name) {
-  if (!friendly_name.empty()) {
-    stream->print(F("\",friendly_name=\""));
-    stream->print(friendly_name.c_str());
-  }
+void PrometheusHandler::begin_row_(std::string &out, const char *metric, EntityBase *obj) {
+  out += metric;
+  out += '{';
+  out += this->label_prefix_(obj);
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_sensor_failed gauge\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value gauge\n";
+  out += "#TYPE esphome_sensor_failed gauge\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_sensor_failed", obj);
+    out += "\"} 0\n";
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_sensor_value", obj);
+    out += "\",unit=\"";
+    out += obj->get_unit_of_measurement();
+    out += "\"} ";
+    append_value(out, obj->state, obj->get_accuracy_decimals());
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_sensor_failed", obj);
+    out += "\"} 1\n";
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed gauge\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value gauge\n";
+  out += "#TYPE esphome_binary_sensor_failed gauge\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj,
-                                           std::string &area, std::string &node, std::string &friendly_name) {
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_binary_sensor_failed", obj);
+    out += "\"} 0\n";
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_binary_sensor_value", obj);
+    out += "\"} ";
+    append_value(out, obj->state);
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_binary_sensor_failed", obj);
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value gauge\n"));
-  stream->print(F("#TYPE esphome_fan_failed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_speed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation gauge\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value gauge\n";
+  out += "#TYPE esphome_fan_failed gauge\n";
+  out += "#TYPE esphome_fan_speed gauge\n";
+  out += "#TYPE esphome_fan_oscillation gauge\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                                 std::string &friendly_name) {
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->begin_row_(out, "esphome_fan_failed", obj);
+  out += "\"} 0\n";
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_fan_value", obj);
+  out += "\"} ";
+  append_value(out, obj->state);
+  out += '\n';
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_fan_speed", obj);
+    out += "\"} ";
+    append_value(out, obj->speed);
+    out += '\n';
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_fan_oscillation", obj);
+    out += "\"} ";
+    append_value(out, obj->oscillating);
+    out += '\n';
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state gauge\n"));
-  stream->print(F("#TYPE esphome_light_color gauge\n"));
-  stream->print(F("#TYPE esphome_light_effect_active gauge\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state gauge\n";
+  out += "#TYPE esphome_light_color gauge\n";
+  out += "#TYPE esphome_light_effect_active gauge\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area,
-                                   std::string &node, std::string &friendly_name) {
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_light_state", obj);
+  out += "\"} ";
+  append_value(out, obj->remote_values.is_on());
+  out += '\n';
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_light_color", obj);
+  out += "\",channel=\"brightness\"} ";
+  append_value(out, brightness);
+  out += '\n';
+  this->begin_row_(out, "esphome_light_color", obj);
+  out += "\",channel=\"r\"} ";
+  append_value(out, r);
+  out += '\n';
+  this->begin_row_(out, "esphome_light_color", obj);
+  out += "\",channel=\"g\"} ";
+  append_value(out, g);
+  out += '\n';
+  this->begin_row_(out, "esphome_light_color", obj);
+  out += "\",channel=\"b\"} ";
+  append_value(out, b);
+  out += '\n';
+  this->begin_row_(out, "esphome_light_color", obj);
+  out += "\",channel=\"w\"} ";
+  append_value(out, w);
+  out += '\n';
   // Effect
   std::string effect = obj->get_effect_name();
+  this->begin_row_(out, "esphome_light_effect_active", obj);
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    out += "\",effect=\"None\"} 0\n";
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    out += "\",effect=\"";
+    out += effect;
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value gauge\n"));
-  stream->print(F("#TYPE esphome_cover_failed gauge\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value gauge\n";
+  out += "#TYPE esphome_cover_failed gauge\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                                   std::string &friendly_name) {
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_cover_failed", obj);
+    out += "\"} 0\n";
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_cover_value", obj);
+    out += "\"} ";
+    append_value(out, obj->position);
+    out += '\n';
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      add_area_label_(stream, area);
-      add_node_label_(stream, node);
-      add_friendly_name_label_(stream, friendly_name);
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print(F("\n"));
+      this->begin_row_(out, "esphome_cover_tilt", obj);
+      out += "\"} ";
+      append_value(out, obj->tilt);
+      out += '\n';
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_cover_failed", obj);
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value gauge\n"));
-  stream->print(F("#TYPE esphome_switch_failed gauge\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value gauge\n";
+  out += "#TYPE esphome_switch_failed gauge\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area,
-                                    std::string &node, std::string &friendly_name) {
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->begin_row_(out, "esphome_switch_failed", obj);
+  out += "\"} 0\n";
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_switch_value", obj);
+  out += "\"} ";
+  append_value(out, obj->state);
+  out += '\n';
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value gauge\n"));
-  stream->print(F("#TYPE esphome_lock_failed gauge\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value gauge\n";
+  out += "#TYPE esphome_lock_failed gauge\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                                  std::string &friendly_name) {
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+  this->begin_row_(out, "esphome_lock_failed", obj);
+  out += "\"} 0\n";
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  add_area_label_(stream, area);
-  add_node_label_(stream, node);
-  add_friendly_name_label_(stream, friendly_name);
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  this->begin_row_(out, "esphome_lock_value", obj);
+  out += "\"} ";
+  append_value(out, obj->state);
+  out += '\n';
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_TEXT_SENSOR
-void PrometheusHandler::text_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_text_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_text_sensor_failed gauge\n"));
+void PrometheusHandler::text_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_text_sensor_value gauge\n";
+  out += "#TYPE esphome_text_sensor_failed gauge\n";
 }
-void PrometheusHandler::text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area,
-                                         std::string &node, std::string &friendly_name) {
+void PrometheusHandler::text_sensor_row_(std::string &out, text_sensor::TextSensor *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    this->begin_row_(out, "esphome_text_sensor_failed", obj);
+    out += "\"} 0\n";
     // Data itself
-    stream->print(F("esphome_text_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",value=\""));
-    stream->print(obj->state.c_str());
-    stream->print(F("\"} "));
-    stream->print(F("1.0"));
-    stream->print(F("\n"));
+    this->begin_row_(out, "esphome_text_sensor_value", obj);
+    out += "\",value=\"";
+    out += obj->state;
+    out += "\"} 1.0\n";
   } else {
     // Invalid state
-    stream->print(F("esphome_text_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    add_area_label_(stream, area);
-    add_node_label_(stream, node);
-    add_friendly_name_label_(stream, friendly_name);
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    this->begin_row_(out, "esphome_text_sensor_failed", obj);
+    out += "\"} 1\n";
   }
 }
 #endif
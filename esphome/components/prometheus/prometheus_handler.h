@@ -2,6 +2,7 @@
 #include "esphome/core/defines.h"
 #ifdef USE_NETWORK
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "esphome/components/web_server_base/web_server_base.h"
@@ -12,7 +13,7 @@
 namespace esphome {
 namespace prometheus {
 
-class PrometheusHandler : public AsyncWebHandler, public Component {
+class PrometheusHandler : public AsyncWebHandler, public Component, public Controller {
  public:
   PrometheusHandler(web_server_base::WebServerBase *base) : base_(base) {}
 
@@ -37,6 +38,13 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
    */
   void add_label_name(EntityBase *obj, const std::string &value) { relabel_map_name_.insert({obj, value}); }
 
+  /** Determine whether the last scrape should be kept, and served again as long as no entity state changed.
+   * Defaults to false.
+   *
+   * @param cache Whether to cache the scrape.
+   */
+  void set_cache(bool cache) { cache_ = cache; }
+
   bool canHandle(AsyncWebServerRequest *request) override {
     if (request->method() == HTTP_GET) {
       if (request->url() == "/metrics")
@@ -48,90 +56,121 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
+#ifdef USE_BINARY_SENSOR
+  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override { this->state_version_++; }
+#endif
+#ifdef USE_FAN
+  void on_fan_update(fan::Fan *obj) override { this->state_version_++; }
+#endif
+#ifdef USE_LIGHT
+  void on_light_update(light::LightState *obj) override { this->state_version_++; }
+#endif
+#ifdef USE_SENSOR
+  void on_sensor_update(sensor::Sensor *obj, float state) override { this->state_version_++; }
+#endif
+#ifdef USE_SWITCH
+  void on_switch_update(switch_::Switch *obj, bool state) override { this->state_version_++; }
+#endif
+#ifdef USE_COVER
+  void on_cover_update(cover::Cover *obj) override { this->state_version_++; }
+#endif
+#ifdef USE_TEXT_SENSOR
+  void on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) override {
+    this->state_version_++;
+  }
+#endif
+#ifdef USE_LOCK
+  void on_lock_update(lock::Lock *obj) override { this->state_version_++; }
+#endif
+
  protected:
   std::string relabel_id_(EntityBase *obj);
   std::string relabel_name_(EntityBase *obj);
-  void add_area_label_(AsyncResponseStream *stream, std::string &area);
-  void add_node_label_(AsyncResponseStream *stream, std::string &node);
-  void add_friendly_name_label_(AsyncResponseStream *stream, std::string &friendly_name);
+  /// The labels shared by all metrics of an entity, built once as they don't change after setup.
+  const std::string &label_prefix_(EntityBase *obj);
+  /// Start a row of a metric with the labels of an entity, leaving the value of its last label open.
+  void begin_row_(std::string &out, const char *metric, EntityBase *obj);
+  /// Render all metrics into the scrape buffer.
+  void render_(std::string &out);
+  /// Whether a scrape can be served from the cache, i.e. no state changed since it was rendered.
+  bool is_cache_valid_();
 
 #ifdef USE_SENSOR
   /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
+  void sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void sensor_row_(std::string &out, sensor::Sensor *obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
+  void binary_sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj, std::string &area,
-                          std::string &node, std::string &friendly_name);
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
+  void fan_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj, std::string &area, std::string &node,
-                std::string &friendly_name);
+  void fan_row_(std::string &out, fan::Fan *obj);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
+  void light_type_(std::string &out);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void light_row_(std::string &out, light::LightState *obj);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
+  void cover_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj, std::string &area, std::string &node,
-                  std::string &friendly_name);
+  void cover_row_(std::string &out, cover::Cover *obj);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
+  void switch_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj, std::string &area, std::string &node,
-                   std::string &friendly_name);
+  void switch_row_(std::string &out, switch_::Switch *obj);
 #endif
 
 #ifdef USE_LOCK
   /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
+  void lock_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj, std::string &area, std::string &node,
-                 std::string &friendly_name);
+  void lock_row_(std::string &out, lock::Lock *obj);
 #endif
 
 #ifdef USE_TEXT_SENSOR
   /// Return the type for prometheus
-  void text_sensor_type_(AsyncResponseStream *stream);
+  void text_sensor_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void text_sensor_row_(AsyncResponseStream *stream, text_sensor::TextSensor *obj, std::string &area, std::string &node,
-                        std::string &friendly_name);
+  void text_sensor_row_(std::string &out, text_sensor::TextSensor *obj);
 #endif
 
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
   std::map<EntityBase *, std::string> relabel_map_name_;
+  /// Labels of each exported entity, from "id" up to and including the value of "name" without its closing quote.
+  std::map<EntityBase *, std::string> label_prefixes_;
+  bool cache_{false};
+  /// Incremented on every state change of an exported entity, when the scrape is cached.
+  uint32_t state_version_{0};
+  uint32_t scrape_version_{0};
+  /// The last scrape, shared with the responses still sending it.
+  std::shared_ptr<std::string> scrape_;
+  /// Size of the last scrape, to reserve the buffer of the next one in one go.
+  size_t scrape_size_{0};
 };
 
 }  // namespace prometheus
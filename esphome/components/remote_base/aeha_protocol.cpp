@@ -40,6 +40,8 @@ void AEHAProtocol::encode(RemoteTransmitData *dst, const AEHAData &data) {
 
   dst->mark(TRAILER);
 }
+bool AEHAProtocol::leader_matches(const RemoteReceiveData &src) { return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US); }
+
 optional<AEHAData> AEHAProtocol::decode(RemoteReceiveData src) {
   AEHAData out{
       .address = 0,
@@ -18,6 +18,7 @@ class AEHAProtocol : public RemoteProtocol<AEHAData> {
  public:
   void encode(RemoteTransmitData *dst, const AEHAData &data) override;
   optional<AEHAData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const AEHAData &data) override;
 
  private:
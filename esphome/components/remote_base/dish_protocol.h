@@ -16,6 +16,7 @@ class DishProtocol : public RemoteProtocol<DishData> {
  public:
   void encode(RemoteTransmitData *dst, const DishData &data) override;
   optional<DishData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const DishData &data) override;
 };
 
@@ -51,6 +51,10 @@ void DooyaProtocol::encode(RemoteTransmitData *dst, const DooyaData &data) {
     }
   }
 }
+bool DooyaProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<DooyaData> DooyaProtocol::decode(RemoteReceiveData src) {
   DooyaData out{
       .id = 0,
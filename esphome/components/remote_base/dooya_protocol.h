@@ -23,6 +23,7 @@ class DooyaProtocol : public RemoteProtocol<DooyaData> {
  public:
   void encode(RemoteTransmitData *dst, const DooyaData &data) override;
   optional<DooyaData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const DooyaData &data) override;
 };
 
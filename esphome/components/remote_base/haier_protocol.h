@@ -16,6 +16,7 @@ class HaierProtocol : public RemoteProtocol<HaierData> {
  public:
   void encode(RemoteTransmitData *dst, const HaierData &data) override;
   optional<HaierData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const HaierData &data) override;
 
  protected:
@@ -17,6 +17,7 @@ class JVCProtocol : public RemoteProtocol<JVCData> {
  public:
   void encode(RemoteTransmitData *dst, const JVCData &data) override;
   optional<JVCData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const JVCData &data) override;
 };
 
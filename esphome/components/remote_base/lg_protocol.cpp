@@ -28,6 +28,8 @@ void LGProtocol::encode(RemoteTransmitData *dst, const LGData &data) {
 
   dst->mark(BIT_HIGH_US);
 }
+bool LGProtocol::leader_matches(const RemoteReceiveData &src) { return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US); }
+
 optional<LGData> LGProtocol::decode(RemoteReceiveData src) {
   LGData out{
       .data = 0,
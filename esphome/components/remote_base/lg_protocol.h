@@ -19,6 +19,7 @@ class LGProtocol : public RemoteProtocol<LGData> {
  public:
   void encode(RemoteTransmitData *dst, const LGData &data) override;
   optional<LGData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const LGData &data) override;
 };
 
@@ -64,6 +64,7 @@ class MideaProtocol : public RemoteProtocol<MideaData> {
  public:
   void encode(RemoteTransmitData *dst, const MideaData &src) override;
   optional<MideaData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const MideaData &data) override;
 };
 
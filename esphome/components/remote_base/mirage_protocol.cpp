@@ -40,6 +40,10 @@ void MirageProtocol::encode_byte_(RemoteTransmitData *dst, uint8_t item) {
   }
 }
 
+bool MirageProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_MARK_US, HEADER_SPACE_US);
+}
+
 optional<MirageData> MirageProtocol::decode(RemoteReceiveData src) {
   if (!src.expect_item(HEADER_MARK_US, HEADER_SPACE_US)) {
     return {};
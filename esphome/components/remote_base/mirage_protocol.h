@@ -16,6 +16,7 @@ class MirageProtocol : public RemoteProtocol<MirageData> {
  public:
   void encode(RemoteTransmitData *dst, const MirageData &data) override;
   optional<MirageData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const MirageData &data) override;
 
  protected:
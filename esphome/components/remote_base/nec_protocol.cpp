@@ -41,6 +41,8 @@ void NECProtocol::encode(RemoteTransmitData *dst, const NECData &data) {
 
   dst->mark(BIT_HIGH_US);
 }
+bool NECProtocol::leader_matches(const RemoteReceiveData &src) { return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US); }
+
 optional<NECData> NECProtocol::decode(RemoteReceiveData src) {
   NECData data{
       .address = 0,
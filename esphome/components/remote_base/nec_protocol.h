@@ -17,6 +17,7 @@ class NECProtocol : public RemoteProtocol<NECData> {
  public:
   void encode(RemoteTransmitData *dst, const NECData &data) override;
   optional<NECData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const NECData &data) override;
 };
 
@@ -35,6 +35,10 @@ void PanasonicProtocol::encode(RemoteTransmitData *dst, const PanasonicData &dat
   }
   dst->mark(BIT_HIGH_US);
 }
+bool PanasonicProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<PanasonicData> PanasonicProtocol::decode(RemoteReceiveData src) {
   PanasonicData out{
       .address = 0,
@@ -19,6 +19,7 @@ class PanasonicProtocol : public RemoteProtocol<PanasonicData> {
  public:
   void encode(RemoteTransmitData *dst, const PanasonicData &data) override;
   optional<PanasonicData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const PanasonicData &data) override;
 };
 
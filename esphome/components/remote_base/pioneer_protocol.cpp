@@ -91,6 +91,10 @@ void PioneerProtocol::encode(RemoteTransmitData *dst, const PioneerData &data) {
     dst->mark(BIT_HIGH_US);
   }
 }
+bool PioneerProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<PioneerData> PioneerProtocol::decode(RemoteReceiveData src) {
   uint16_t address1 = 0;
   uint16_t command1 = 0;
@@ -16,6 +16,7 @@ class PioneerProtocol : public RemoteProtocol<PioneerData> {
  public:
   void encode(RemoteTransmitData *dst, const PioneerData &data) override;
   optional<PioneerData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const PioneerData &data) override;
 };
 
@@ -238,13 +238,32 @@ uint64_t decode_binary_string_mask(const std::string &data) {
   return ret;
 }
 
+/// A code decoded with the timings of one protocol.
+struct RCSwitchCode {
+  uint64_t code;
+  uint8_t nbits;
+};
+
+static optional<RCSwitchCode> decode_code(const RCSwitchBase &protocol, RemoteReceiveData &src) {
+  RCSwitchCode out;
+  if (!protocol.decode(src, &out.code, &out.nbits))
+    return {};
+  return out;
+}
+
 bool RCSwitchRawReceiver::matches(RemoteReceiveData src) {
-  uint64_t decoded_code;
-  uint8_t decoded_nbits;
-  if (!this->protocol_.decode(src, &decoded_code, &decoded_nbits))
+  RemoteDecodeCache *cache = src.get_decode_cache();
+  optional<RCSwitchCode> decoded;
+  if (cache == nullptr) {
+    decoded = decode_code(this->protocol_, src);
+  } else {
+    // receivers with the same protocol timings share the decoded code of a burst
+    decoded = cache->decode<RCSwitchBase, optional<RCSwitchCode>>(this->protocol_, src, decode_code);
+  }
+  if (!decoded.has_value())
     return false;
 
-  return decoded_nbits == this->nbits_ && (decoded_code & this->mask_) == (this->code_ & this->mask_);
+  return decoded->nbits == this->nbits_ && (decoded->code & this->mask_) == (this->code_ & this->mask_);
 }
 bool RCSwitchDumper::dump(RemoteReceiveData src) {
   for (uint8_t i = 1; i <= 8; i++) {
@@ -39,6 +39,15 @@ class RCSwitchBase {
 
   optional<RCSwitchData> decode(RemoteReceiveData &src) const;
 
+  // the sync pulse differs between the protocols, so any burst can match
+  bool leader_matches(const RemoteReceiveData &src) const { return true; }
+
+  bool operator==(const RCSwitchBase &rhs) const {
+    return this->sync_high_ == rhs.sync_high_ && this->sync_low_ == rhs.sync_low_ &&
+           this->zero_high_ == rhs.zero_high_ && this->zero_low_ == rhs.zero_low_ && this->one_high_ == rhs.one_high_ &&
+           this->one_low_ == rhs.one_low_ && this->inverted_ == rhs.inverted_;
+  }
+
   static void simple_code_to_tristate(uint16_t code, uint8_t nbits, uint64_t *out_code);
 
   static void type_a_code(uint8_t switch_group, uint8_t switch_device, bool state, uint64_t *out_code,
@@ -1,3 +1,4 @@
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -45,10 +46,17 @@ class RemoteTransmitData {
   uint32_t carrier_frequency_{0};
 };
 
+class RemoteDecodeCache;
+
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode)
-      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode,
+                             RemoteDecodeCache *decode_cache = nullptr)
+      : data_(data),
+        index_(0),
+        tolerance_(tolerance),
+        tolerance_mode_(tolerance_mode),
+        decode_cache_(decode_cache) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
@@ -76,6 +84,8 @@ class RemoteReceiveData {
   }
   uint32_t get_tolerance() { return tolerance_; }
   ToleranceMode get_tolerance_mode() { return this->tolerance_mode_; }
+  /// The decode results shared by everything that receives this burst, nullptr if there are none.
+  RemoteDecodeCache *get_decode_cache() const { return this->decode_cache_; }
 
  protected:
   int32_t lower_bound_(uint32_t length) const {
@@ -99,6 +109,88 @@ class RemoteReceiveData {
   uint32_t index_;
   uint32_t tolerance_;
   ToleranceMode tolerance_mode_;
+  RemoteDecodeCache *decode_cache_;
+};
+
+/** Results of decoding one received burst with each protocol.
+ *
+ * Every listener and dumper of a protocol shares the result, so a burst is decoded at most once per protocol however
+ * many binary sensors, triggers and dumpers use that protocol. Results are kept per protocol type, or per protocol
+ * value for protocols with parameters, and only cleared by starting the next burst, so they don't cause allocations
+ * after the first burst.
+ */
+class RemoteDecodeCache {
+ public:
+  /// Forget the results of the previous burst.
+  void next_burst() { this->burst_++; }
+
+  /// The result of decoding src with protocol T, decoding it only the first time it is asked for in a burst.
+  template<typename T> const optional<typename T::ProtocolData> &decode(RemoteReceiveData src) {
+    auto *entry = static_cast<Entry<T> *>(this->find_entry_(type_key_<T>()));
+    if (entry == nullptr) {
+      entry = new Entry<T>();  // NOLINT(cppcoreguidelines-owning-memory)
+      this->entries_.emplace_back(type_key_<T>(), std::unique_ptr<EntryBase>(entry));
+    }
+    if (entry->burst != this->burst_) {
+      T protocol;
+      entry->result = protocol.leader_matches(src) ? protocol.decode(src) : nullopt;
+      entry->burst = this->burst_;
+    }
+    return entry->result;
+  }
+
+  /// The result of decoder(protocol, src) for a protocol whose parameters change the result, like the timings of an RC
+  /// switch protocol. Protocols of type T that compare equal share the result, decoding it once per burst.
+  template<typename T, typename R, typename F> const R &decode(const T &protocol, RemoteReceiveData src, F decoder) {
+    using E = KeyedEntry<T, R>;
+    E *entry = nullptr;
+    for (auto &it : this->entries_) {
+      if (it.first == type_key_<E>() && static_cast<E *>(it.second.get())->protocol == protocol) {
+        entry = static_cast<E *>(it.second.get());
+        break;
+      }
+    }
+    if (entry == nullptr) {
+      entry = new E(protocol);  // NOLINT(cppcoreguidelines-owning-memory)
+      this->entries_.emplace_back(type_key_<E>(), std::unique_ptr<EntryBase>(entry));
+    }
+    if (entry->burst != this->burst_) {
+      entry->result = decoder(protocol, src);
+      entry->burst = this->burst_;
+    }
+    return entry->result;
+  }
+
+ protected:
+  struct EntryBase {
+    virtual ~EntryBase() = default;
+    uint32_t burst{0};
+  };
+  template<typename T> struct Entry : EntryBase {
+    optional<typename T::ProtocolData> result;
+  };
+  template<typename T, typename R> struct KeyedEntry : EntryBase {
+    explicit KeyedEntry(const T &protocol) : protocol(protocol) {}
+    T protocol;
+    R result{};
+  };
+
+  // a unique address per protocol type, which works without RTTI
+  template<typename T> static const void *type_key_() {
+    static const char KEY = 0;
+    return &KEY;
+  }
+  EntryBase *find_entry_(const void *key) {
+    for (auto &entry : this->entries_) {
+      if (entry.first == key)
+        return entry.second.get();
+    }
+    return nullptr;
+  }
+
+  std::vector<std::pair<const void *, std::unique_ptr<EntryBase>>> entries_;
+  // starts above the burst of new entries, so they are always decoded
+  uint32_t burst_{1};
 };
 
 class RemoteComponentBase {
@@ -198,14 +290,20 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_listeners_();
   void call_dumpers_();
   void call_listeners_dumpers_() {
+    this->decode_cache_.next_burst();
     this->call_listeners_();
     this->call_dumpers_();
   }
 
+  RemoteReceiveData make_data_() {
+    return RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_);
+  }
+
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
   RawTimings temp_;
+  RemoteDecodeCache decode_cache_;
   uint32_t tolerance_{25};
   ToleranceMode tolerance_mode_{TOLERANCE_MODE_PERCENTAGE};
 };
@@ -228,16 +326,32 @@ template<typename T> class RemoteProtocol {
   virtual void encode(RemoteTransmitData *dst, const ProtocolData &data) = 0;
   virtual optional<ProtocolData> decode(RemoteReceiveData src) = 0;
   virtual void dump(const ProtocolData &data) = 0;
+  /// Quick check of the leader of a burst, which lets the decode cache skip protocols that can't match without
+  /// decoding. Protocols that start with a fixed header override it.
+  virtual bool leader_matches(const RemoteReceiveData &src) { return true; }
 };
 
+/// Decode src with protocol T, sharing the result with everything else that receives the same burst.
+template<typename T> optional<typename T::ProtocolData> decode_shared(RemoteReceiveData src) {
+  RemoteDecodeCache *cache = src.get_decode_cache();
+  if (cache == nullptr)
+    return T().decode(src);
+  return cache->decode<T>(src);
+}
+
 template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    RemoteDecodeCache *cache = src.get_decode_cache();
+    if (cache == nullptr) {
+      auto res = T().decode(src);
+      return res.has_value() && *res == this->data_;
+    }
+    // compare against the shared result without copying it
+    const auto &res = cache->decode<T>(src);
     return res.has_value() && *res == this->data_;
   }
 
@@ -252,8 +366,7 @@ template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
+    auto res = decode_shared<T>(src);
     if (res.has_value()) {
       this->trigger(*res);
       return true;
@@ -294,11 +407,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
+    auto decoded = decode_shared<T>(src);
     if (!decoded.has_value())
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
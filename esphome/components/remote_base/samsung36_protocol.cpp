@@ -50,6 +50,10 @@ void Samsung36Protocol::encode(RemoteTransmitData *dst, const Samsung36Data &dat
   dst->item(FOOTER_HIGH_US, FOOTER_LOW_US);
 }
 
+bool Samsung36Protocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<Samsung36Data> Samsung36Protocol::decode(RemoteReceiveData src) {
   Samsung36Data out{
       .address = 0,
@@ -19,6 +19,7 @@ class Samsung36Protocol : public RemoteProtocol<Samsung36Data> {
  public:
   void encode(RemoteTransmitData *dst, const Samsung36Data &data) override;
   optional<Samsung36Data> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const Samsung36Data &data) override;
 };
 
@@ -31,6 +31,10 @@ void SamsungProtocol::encode(RemoteTransmitData *dst, const SamsungData &data) {
 
   dst->item(FOOTER_HIGH_US, FOOTER_LOW_US);
 }
+bool SamsungProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<SamsungData> SamsungProtocol::decode(RemoteReceiveData src) {
   SamsungData out{
       .data = 0,
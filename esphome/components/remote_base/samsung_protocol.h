@@ -17,6 +17,7 @@ class SamsungProtocol : public RemoteProtocol<SamsungData> {
  public:
   void encode(RemoteTransmitData *dst, const SamsungData &data) override;
   optional<SamsungData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const SamsungData &data) override;
 };
 
@@ -26,6 +26,8 @@ void SonyProtocol::encode(RemoteTransmitData *dst, const SonyData &data) {
     }
   }
 }
+bool SonyProtocol::leader_matches(const RemoteReceiveData &src) { return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US); }
+
 optional<SonyData> SonyProtocol::decode(RemoteReceiveData src) {
   SonyData out{
       .data = 0,
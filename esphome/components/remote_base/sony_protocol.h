@@ -19,6 +19,7 @@ class SonyProtocol : public RemoteProtocol<SonyData> {
  public:
   void encode(RemoteTransmitData *dst, const SonyData &data) override;
   optional<SonyData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const SonyData &data) override;
 };
 
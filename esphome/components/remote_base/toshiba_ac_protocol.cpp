@@ -47,6 +47,10 @@ void ToshibaAcProtocol::encode(RemoteTransmitData *dst, const ToshibaAcData &dat
   }
 }
 
+bool ToshibaAcProtocol::leader_matches(const RemoteReceiveData &src) {
+  return src.peek_item(HEADER_HIGH_US, HEADER_LOW_US);
+}
+
 optional<ToshibaAcData> ToshibaAcProtocol::decode(RemoteReceiveData src) {
   uint64_t packet = 0;
   ToshibaAcData out{
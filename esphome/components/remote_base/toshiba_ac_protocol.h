@@ -17,6 +17,7 @@ class ToshibaAcProtocol : public RemoteProtocol<ToshibaAcData> {
  public:
   void encode(RemoteTransmitData *dst, const ToshibaAcData &data) override;
   optional<ToshibaAcData> decode(RemoteReceiveData src) override;
+  bool leader_matches(const RemoteReceiveData &src) override;
   void dump(const ToshibaAcData &data) override;
 };
 
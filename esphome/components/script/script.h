@@ -100,6 +100,7 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
       this->esp_logd_(__LINE__, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
       this->num_runs_++;
       this->var_queue_.push(std::make_tuple(x...));
+      this->enable_loop();
       return;
     }
 
@@ -114,7 +115,11 @@ template<typename... Ts> class QueueingScript : public Script<Ts...>, public Com
   }
 
   void loop() override {
-    if (this->num_runs_ != 0 && !this->is_action_running()) {
+    if (this->num_runs_ == 0) {
+      this->disable_loop();
+      return;
+    }
+    if (!this->is_action_running()) {
       this->num_runs_--;
       auto &vars = this->var_queue_.front();
       this->var_queue_.pop();
@@ -226,12 +231,15 @@ template<class C, typename... Ts> class ScriptWaitAction : public Action<Ts...>,
       return;
     }
     this->var_ = std::make_tuple(x...);
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (this->script_->is_running())
       return;
@@ -1,6 +1,8 @@
 #ifdef USE_HOST
 #include "sdl_esphome.h"
 #include "esphome/components/display/display_color_utils.h"
+#include <algorithm>
+#include <vector>
 
 namespace esphome {
 namespace sdl {
@@ -61,6 +63,31 @@ void Sdl::draw_pixel_at(int x, int y, Color color) {
     this->y_high_ = y;
 }
 
+void Sdl::draw_pixel_row_at(int x, int y, const Color *colors, int count) {
+  if (this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES) {
+    Display::draw_pixel_row_at(x, y, colors, count);
+    return;
+  }
+  int start = std::max(0, -x);
+  int end = std::min(count, this->width_ - x);
+  if (y < 0 || y >= this->height_ || start >= end)
+    return;
+  // update the texture once for the run rather than once per pixel
+  std::vector<uint16_t> data(end - start);
+  for (int i = start; i != end; i++)
+    data[i - start] = display::ColorUtil::color_to_565(colors[i], display::COLOR_ORDER_RGB);
+  SDL_Rect rect{x + start, y, end - start, 1};
+  SDL_UpdateTexture(this->texture_, &rect, data.data(), (end - start) * 2);
+  if (x + start < this->x_low_)
+    this->x_low_ = x + start;
+  if (y < this->y_low_)
+    this->y_low_ = y;
+  if (x + end - 1 > this->x_high_)
+    this->x_high_ = x + end - 1;
+  if (y > this->y_high_)
+    this->y_high_ = y;
+}
+
 void Sdl::loop() {
   SDL_Event e;
   if (SDL_PollEvent(&e)) {
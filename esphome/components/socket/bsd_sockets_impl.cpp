@@ -4,6 +4,7 @@
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
+#include <algorithm>
 #include <cstring>
 
 #ifdef USE_ESP32
@@ -114,6 +115,36 @@ class BSDSocketImpl : public Socket {
     return ::sendto(fd_, buf, len, flags, to, tolen);
   }
 
+#if defined(USE_HOST) && defined(__linux__)
+  int sendto_multiple(const Datagram *datagrams, size_t count, int flags) override {
+    // sent in batches, to keep the message headers on the stack
+    static const size_t BATCH_SIZE = 16;
+    struct mmsghdr msgs[BATCH_SIZE];
+    struct iovec iovs[BATCH_SIZE];
+    size_t sent = 0;
+    while (sent != count) {
+      size_t batch = std::min(count - sent, BATCH_SIZE);
+      memset(msgs, 0, sizeof(msgs));
+      for (size_t i = 0; i != batch; i++) {
+        const Datagram &datagram = datagrams[sent + i];
+        iovs[i].iov_base = const_cast<void *>(datagram.buf);
+        iovs[i].iov_len = datagram.len;
+        msgs[i].msg_hdr.msg_name = const_cast<struct sockaddr *>(datagram.to);
+        msgs[i].msg_hdr.msg_namelen = datagram.tolen;
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+      int result = ::sendmmsg(fd_, msgs, batch, flags);
+      if (result < 0)
+        return sent == 0 ? -1 : static_cast<int>(sent);
+      sent += result;
+      if (static_cast<size_t>(result) != batch)
+        break;
+    }
+    return static_cast<int>(sent);
+  }
+#endif
+
   int setblocking(bool blocking) override {
     int fl = ::fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -0,0 +1,55 @@
+#include "datagram_packer.h"
+
+namespace esphome {
+namespace socket {
+
+bool DatagramPacker::add(const void *data, size_t len) {
+  if (this->open_ && this->current_size_() + len > this->max_size_)
+    this->finish();
+  if (!this->open_) {
+    this->open_ = true;
+    if (this->begin_callback_)
+      this->begin_callback_();
+    this->header_size_ = this->current_size_();
+    if (this->header_size_ + len > this->max_size_) {
+      this->buffer_.resize(this->start_);
+      this->open_ = false;
+      return false;
+    }
+  }
+  this->append(data, len);
+  return true;
+}
+
+void DatagramPacker::append(const void *data, size_t len) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  this->buffer_.insert(this->buffer_.end(), bytes, bytes + len);
+}
+
+void DatagramPacker::finish() {
+  if (!this->open_)
+    return;
+  this->open_ = false;
+  size_t len = this->current_size_();
+  if (len == this->header_size_) {
+    this->buffer_.resize(this->start_);
+    return;
+  }
+  if (this->finish_callback_) {
+    this->buffer_.resize(this->start_ + this->max_size_);
+    this->finish_callback_(this->buffer_.data() + this->start_, len);
+    this->buffer_.resize(this->start_ + len);
+  }
+  this->ends_.push_back(this->buffer_.size());
+  this->start_ = this->buffer_.size();
+}
+
+void DatagramPacker::clear() {
+  this->buffer_.clear();
+  this->ends_.clear();
+  this->start_ = 0;
+  this->open_ = false;
+}
+
+}  // namespace socket
+}  // namespace esphome
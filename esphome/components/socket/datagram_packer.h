@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace socket {
+
+/**
+ * Packs records into as few datagrams as possible, none of them larger than a maximum size, such as what fits into
+ * the MTU without fragmentation. A record is never split over two datagrams.
+ *
+ * All datagrams of an update are kept in a single buffer, so that they can be sent together, e.g. with
+ * Socket::sendto_multiple(). The buffer is kept between updates, so packing doesn't allocate once it has grown.
+ */
+class DatagramPacker {
+ public:
+  explicit DatagramPacker(size_t max_size) : max_size_(max_size) {}
+
+  /// Set a callback that starts every datagram, by append()ing the bytes that precede its records (e.g. a header).
+  void set_begin_callback(std::function<void()> &&callback) { this->begin_callback_ = std::move(callback); }
+  /**
+   * Set a callback that completes every datagram, e.g. to pad or encrypt it. It gets the bytes of the datagram, and
+   * may change them in place and grow them up to the maximum size by updating the length.
+   */
+  void set_finish_callback(std::function<void(uint8_t *data, size_t &len)> &&callback) {
+    this->finish_callback_ = std::move(callback);
+  }
+
+  /// Add a record, in a new datagram if it doesn't fit into the current one. Returns false if it fits into none.
+  bool add(const void *data, size_t len);
+  /// Add bytes to the current datagram without checking its size, for use by the begin callback.
+  void append(const void *data, size_t len);
+  /// Complete the current datagram, so that the next record starts a new one. Datagrams without records are dropped.
+  void finish();
+  /// Remove all datagrams.
+  void clear();
+
+  /// Number of completed datagrams.
+  size_t get_count() const { return this->ends_.size(); }
+  const uint8_t *get_data(size_t index) const { return this->buffer_.data() + this->get_start_(index); }
+  size_t get_size(size_t index) const { return this->ends_[index] - this->get_start_(index); }
+  /// Number of bytes in the completed datagrams.
+  size_t get_total_size() const { return this->ends_.empty() ? 0 : this->ends_.back(); }
+  size_t get_max_size() const { return this->max_size_; }
+
+ protected:
+  size_t get_start_(size_t index) const { return index == 0 ? 0 : this->ends_[index - 1]; }
+  size_t current_size_() const { return this->buffer_.size() - this->start_; }
+
+  std::vector<uint8_t> buffer_;
+  /// End of each completed datagram in the buffer.
+  std::vector<size_t> ends_;
+  /// Start of the current datagram in the buffer.
+  size_t start_{0};
+  /// Size of the bytes added by the begin callback to the current datagram.
+  size_t header_size_{0};
+  bool open_{false};
+  size_t max_size_;
+  std::function<void()> begin_callback_;
+  std::function<void(uint8_t *data, size_t &len)> finish_callback_;
+};
+
+}  // namespace socket
+}  // namespace esphome
@@ -10,6 +10,15 @@ namespace socket {
 
 Socket::~Socket() {}
 
+int Socket::sendto_multiple(const Datagram *datagrams, size_t count, int flags) {
+  for (size_t i = 0; i != count; i++) {
+    const Datagram &datagram = datagrams[i];
+    if (this->sendto(datagram.buf, datagram.len, flags, datagram.to, datagram.tolen) < 0)
+      return i == 0 ? -1 : static_cast<int>(i);
+  }
+  return static_cast<int>(count);
+}
+
 std::unique_ptr<Socket> socket_ip(int type, int protocol) {
 #if USE_NETWORK_IPV6
   return socket(AF_INET6, type, protocol);
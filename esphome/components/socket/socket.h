@@ -9,6 +9,14 @@
 namespace esphome {
 namespace socket {
 
+/// A datagram to send with Socket::sendto_multiple().
+struct Datagram {
+  const void *buf;
+  size_t len;
+  const struct sockaddr *to;
+  socklen_t tolen;
+};
+
 class Socket {
  public:
   Socket() = default;
@@ -39,6 +47,9 @@ class Socket {
   virtual ssize_t write(const void *buf, size_t len) = 0;
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) = 0;
+  /// Send several datagrams, with a single system call where the platform supports it. Returns the number of
+  /// datagrams sent, which is less than count when one could not be sent (with errno set), or -1 if none was sent.
+  virtual int sendto_multiple(const Datagram *datagrams, size_t count, int flags);
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
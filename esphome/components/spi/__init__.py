@@ -28,6 +28,7 @@ from esphome.const import (
     KEY_VARIANT,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
 )
 from esphome.core import CORE, coroutine_with_priority
@@ -127,6 +128,8 @@ def get_hw_interface_list():
         return [["spi", "spi2"], ["spi3"]]
     if target_platform == PLATFORM_RP2040:
         return [["spi"], ["spi1"]]
+    if target_platform == PLATFORM_HOST:
+        return [["host"]]
     return []
 
 
@@ -185,7 +188,9 @@ def validate_hw_pins(spi, index=-1):
         if sdi_pin_no not in pin_set[CONF_MISO_PIN]:
             return False
         return True
-    return False
+
+    # the host bus is simulated, so any pins will do
+    return target_platform == PLATFORM_HOST
 
 
 def get_hw_spi(config, available):
@@ -241,6 +246,8 @@ def validate_spi_config(config):
 
 # Given an SPI index, convert to a string that represents the C++ object for it.
 def get_spi_interface(index):
+    if CORE.is_host:
+        return str(index)
     if CORE.using_esp_idf:
         return ["SPI2_HOST", "SPI3_HOST"][index]
     # Arduino code follows
@@ -275,7 +282,7 @@ SPI_SCHEMA = cv.All(
         }
     ),
     cv.has_at_least_one_key(CONF_MISO_PIN, CONF_MOSI_PIN),
-    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040, PLATFORM_HOST]),
 )
 
 SPI_QUAD_SCHEMA = cv.All(
@@ -337,11 +344,14 @@ async def to_code(configs):
         if (index := spi.get(CONF_INTERFACE_INDEX)) is not None:
             interface = get_spi_interface(index)
             cg.add(var.set_interface(cg.RawExpression(interface)))
-            cg.add(
-                var.set_interface_name(
-                    re.sub(r"\W", "", interface.replace("new SPIClass", ""))
+            if CORE.is_host:
+                cg.add(var.set_interface_name("host"))
+            else:
+                cg.add(
+                    var.set_interface_name(
+                        re.sub(r"\W", "", interface.replace("new SPIClass", ""))
+                    )
                 )
-            )
 
 
 def spi_device_schema(
@@ -1,6 +1,8 @@
 #include "spi.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include <algorithm>
 
 namespace esphome {
 namespace spi {
@@ -75,6 +77,47 @@ void SPIComponent::dump_config() {
   }
 }
 
+SPIDoubleBuffer::~SPIDoubleBuffer() {
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  for (auto *buffer : this->buffers_) {
+    if (buffer != nullptr)
+      allocator.deallocate(buffer, this->size_);
+  }
+}
+
+bool SPIDoubleBuffer::allocate(size_t size) {
+  RAMAllocator<uint8_t> allocator(RAMAllocator<uint8_t>::ALLOC_INTERNAL);
+  for (auto *&buffer : this->buffers_) {
+    if (buffer != nullptr)
+      allocator.deallocate(buffer, this->size_);
+    buffer = allocator.allocate(size);
+  }
+  if (this->buffers_[0] == nullptr || this->buffers_[1] == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate %zu bytes for SPI buffers", size * 2);
+    this->size_ = 0;
+    return false;
+  }
+  this->size_ = size;
+  return true;
+}
+
+uint8_t *SPIDoubleBuffer::get_buffer(SPIDelegate *delegate) {
+  uint8_t index = this->current_;
+  // the callback of the transfer clears the flag, so waiting for the oldest transfers eventually frees this buffer
+  while (this->busy_[index] && delegate->poll_queued_transfers(true) != 0)
+    continue;
+  this->busy_[index] = false;
+  return this->buffers_[index];
+}
+
+void SPIDoubleBuffer::submit(SPIDelegate *delegate, size_t length) {
+  uint8_t index = this->current_;
+  this->busy_[index] = true;
+  this->current_ = index ^ 1;
+  delegate->queue_transfer(this->buffers_[index], nullptr, std::min(length, this->size_),
+                           [this, index](bool success) { this->busy_[index] = false; });
+}
+
 uint8_t SPIDelegateBitBash::transfer(uint8_t data) { return this->transfer_(data, 8); }
 
 void SPIDelegateBitBash::write(uint16_t data, size_t num_bits) { this->transfer_(data, num_bits); }
@@ -4,6 +4,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include <functional>
 #include <map>
 #include <utility>
 #include <vector>
@@ -28,6 +29,13 @@ using SPIInterface = spi_host_device_t;
 
 #endif  // USE_ESP_IDF
 
+#ifdef USE_HOST
+
+// the host platform has a single simulated bus
+using SPIInterface = int;
+
+#endif  // USE_HOST
+
 /**
  * Implementation of SPI Controller mode.
  */
@@ -79,6 +87,10 @@ enum SPIMode {
   MODE2 = 2,
   MODE3 = 3,
 };
+
+/// Called when a queued transfer has completed, with false if it failed.
+using SPITransferCallback = std::function<void(bool success)>;
+
 /** The SPI clock signal frequency, which determines the transfer bit rate/second.
  *
  * Implementations can use the pre-defined constants here, or use an integer in the template definition
@@ -240,6 +252,43 @@ class SPIDelegate {
       ptr[i] = this->transfer(0);
   }
 
+  /**
+   * Queue a transfer of caller-provided buffers, either of which may be null. The transfer runs in the background
+   * where the hardware supports it, the buffers must stay valid and unchanged until the callback has been called.
+   * Queued transfers belong to the current transaction, end_transaction() and any synchronous transfer wait for them
+   * to complete first. This implementation completes the transfer before returning.
+   * @param txbuf Data to write, null to write zeros
+   * @param rxbuf Buffer for the data read, null to discard it
+   * @param length Number of bytes to transfer
+   * @param callback Called from poll_queued_transfers() once the transfer has completed or failed
+   */
+  virtual void queue_transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length,
+                              SPITransferCallback &&callback = nullptr) {
+    if (txbuf == nullptr) {
+      if (rxbuf != nullptr)
+        this->read_array(rxbuf, length);
+    } else if (rxbuf == nullptr) {
+      this->write_array(txbuf, length);
+    } else {
+      this->transfer(txbuf, rxbuf, length);
+    }
+    if (callback)
+      callback(true);
+  }
+
+  /**
+   * Call the callbacks of queued transfers that have completed.
+   * @param block Wait for the oldest queued transfer to complete if none has yet
+   * @return The number of transfers still queued
+   */
+  virtual size_t poll_queued_transfers(bool block = false) { return 0; }
+
+  /// Wait until all queued transfers have completed.
+  void wait_queued_transfers() {
+    while (this->poll_queued_transfers(true) != 0)
+      continue;
+  }
+
   // check if device is ready
   virtual bool is_ready();
 
@@ -350,6 +399,35 @@ class SPIComponent : public Component {
 };
 
 using QuadSPIComponent = SPIComponent;
+
+/**
+ * Two transfer buffers for streaming data to a device: one is filled while the other one is transmitted.
+ *
+ * Fill the buffer returned by get_buffer() and pass it on with submit(), which queues it and switches to the other
+ * buffer. get_buffer() only waits when the transfer of the previous contents of that buffer is still running. The
+ * buffers are in internal memory, so DMA can read them directly. Pending transfers must have completed before the
+ * SPIDoubleBuffer is destroyed.
+ */
+class SPIDoubleBuffer {
+ public:
+  ~SPIDoubleBuffer();
+
+  /// Allocate both buffers, returns false if out of memory.
+  bool allocate(size_t size);
+  size_t get_size() const { return this->size_; }
+
+  /// The buffer to fill next, waits until its previous transfer has completed.
+  uint8_t *get_buffer(SPIDelegate *delegate);
+  /// Queue the first length bytes of the buffer for writing, and switch to the other buffer.
+  void submit(SPIDelegate *delegate, size_t length);
+
+ protected:
+  uint8_t *buffers_[2]{};
+  bool busy_[2]{};
+  uint8_t current_{0};
+  size_t size_{0};
+};
+
 /**
  * Base class for SPIDevice, un-templated.
  */
@@ -471,6 +549,20 @@ class SPIDevice : public SPIClient {
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
+
+  /**
+   * Queue writing a buffer in the background, see SPIDelegate::queue_transfer().
+   * @param data The data, which must stay valid and unchanged until the callback has been called
+   * @param length Number of bytes to write
+   * @param callback Called once the data has been written
+   */
+  void queue_write_array(const uint8_t *data, size_t length, SPITransferCallback &&callback = nullptr) {
+    this->delegate_->queue_transfer(data, nullptr, length, std::move(callback));
+  }
+
+  size_t poll_queued_transfers(bool block = false) { return this->delegate_->poll_queued_transfers(block); }
+
+  void wait_queued_transfers() { this->delegate_->wait_queued_transfers(); }
 };
 
 }  // namespace spi
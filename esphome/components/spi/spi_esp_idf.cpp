@@ -1,4 +1,5 @@
 #include "spi.h"
+#include <array>
 #include <vector>
 
 namespace esphome {
@@ -7,6 +8,7 @@ namespace spi {
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const size_t QUEUE_SIZE = 4;           // transfers queued with interrupt/DMA transactions
 
 class SPIDelegateHw : public SPIDelegate {
  public:
@@ -18,7 +20,7 @@ class SPIDelegateHw : public SPIDelegate {
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
+    config.queue_size = QUEUE_SIZE;
     config.pre_cb = nullptr;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
@@ -44,12 +46,14 @@ class SPIDelegateHw : public SPIDelegate {
 
   void end_transaction() override {
     if (this->is_ready()) {
+      this->wait_queued_transfers();
       SPIDelegate::end_transaction();
       spi_device_release_bus(this->handle_);
     }
   }
 
   ~SPIDelegateHw() override {
+    this->wait_queued_transfers();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -64,6 +68,8 @@ class SPIDelegateHw : public SPIDelegate {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
     }
+    // polling transactions can't be started while interrupt transactions are pending
+    this->wait_queued_transfers();
     spi_transaction_t desc = {};
     desc.flags = 0;
     while (length != 0) {
@@ -90,6 +96,7 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   void write(uint16_t data, size_t num_bits) override {
+    this->wait_queued_transfers();
     spi_transaction_ext_t desc = {};
     desc.command_bits = num_bits;
     desc.base.flags = SPI_TRANS_VARIABLE_CMD;
@@ -121,6 +128,7 @@ class SPIDelegateHw : public SPIDelegate {
       esph_log_w(TAG, "Nothing to transfer");
       return;
     }
+    this->wait_queued_transfers();
     desc.base.flags = SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_DUMMY;
     if (bus_width == 4) {
       desc.base.flags |= SPI_TRANS_MODE_QIO;
@@ -188,10 +196,71 @@ class SPIDelegateHw : public SPIDelegate {
 
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
+  // queue interrupt transactions, which the driver runs with DMA. Transfers above the maximum size are split, with
+  // the callback attached to the last part.
+  void queue_transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length, SPITransferCallback &&callback) override {
+    if (!this->is_ready() || (rxbuf != nullptr && this->write_only_)) {
+      ESP_LOGE(TAG, "Cannot queue transfer");
+      if (callback)
+        callback(false);
+      return;
+    }
+    do {
+      if (this->queue_count_ == QUEUE_SIZE)
+        this->poll_queued_transfers(true);
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      size_t index = (this->queue_head_ + this->queue_count_) % QUEUE_SIZE;
+      spi_transaction_t &desc = this->queue_descs_[index];
+      desc = {};
+      desc.length = partial * 8;
+      desc.rxlength = this->write_only_ ? 0 : partial * 8;
+      desc.tx_buffer = txbuf;
+      desc.rx_buffer = rxbuf;
+      length -= partial;
+      if (txbuf != nullptr)
+        txbuf += partial;
+      if (rxbuf != nullptr)
+        rxbuf += partial;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, &desc, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Queueing transfer failed - err %X", err);
+        if (callback)
+          callback(false);
+        return;
+      }
+      if (length == 0)
+        this->queue_callbacks_[index] = std::move(callback);
+      this->queue_count_++;
+    } while (length != 0);
+  }
+
+  // results of a device are returned in the order the transactions were queued
+  size_t poll_queued_transfers(bool block) override {
+    while (this->queue_count_ != 0) {
+      spi_transaction_t *desc;
+      esp_err_t const err = spi_device_get_trans_result(this->handle_, &desc, block ? portMAX_DELAY : 0);
+      if (err != ESP_OK)
+        break;
+      block = false;
+      size_t index = this->queue_head_;
+      this->queue_head_ = (index + 1) % QUEUE_SIZE;
+      this->queue_count_--;
+      SPITransferCallback callback = std::move(this->queue_callbacks_[index]);
+      this->queue_callbacks_[index] = nullptr;
+      if (callback)
+        callback(true);
+    }
+    return this->queue_count_;
+  }
+
  protected:
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  std::array<spi_transaction_t, QUEUE_SIZE> queue_descs_{};
+  std::array<SPITransferCallback, QUEUE_SIZE> queue_callbacks_{};
+  size_t queue_head_{0};
+  size_t queue_count_{0};
 };
 
 class SPIBusHw : public SPIBus {
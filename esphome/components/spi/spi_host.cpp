@@ -0,0 +1,115 @@
+#ifdef USE_HOST
+
+#include "spi_host.h"
+#include "esphome/core/hal.h"
+#include <cinttypes>
+#include <cstring>
+
+namespace esphome {
+namespace spi {
+
+static const char *const TAG = "spi.host";
+
+static bool is_before(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) < 0; }
+
+uint32_t SPIDelegateHost::schedule_(size_t cycles, size_t length) {
+  uint32_t now = micros();
+  uint32_t start = now;
+  if (!this->queue_.empty() && is_before(now, this->queue_.back().end))
+    start = this->queue_.back().end;
+  uint32_t duration = static_cast<uint32_t>(cycles * 1000000ULL / this->data_rate_);
+  this->transferred_bytes_ += length;
+  this->busy_time_ += duration;
+  if (this->records_.size() == MAX_RECORDS)
+    this->records_.pop_front();
+  this->records_.push_back({.queued = now, .start = start, .end = start + duration, .length = length});
+  return start + duration;
+}
+
+void SPIDelegateHost::simulate_(size_t cycles, size_t length) {
+  this->wait_queued_transfers();
+  uint32_t end = this->schedule_(cycles, length);
+  uint32_t now = micros();
+  if (is_before(now, end))
+    delayMicroseconds(end - now);
+}
+
+void SPIDelegateHost::transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) {
+  this->simulate_(length * 8, length);
+  if (rxbuf == nullptr || rxbuf == txbuf)
+    return;
+  if (txbuf == nullptr) {
+    memset(rxbuf, 0, length);
+  } else {
+    memcpy(rxbuf, txbuf, length);
+  }
+}
+
+void SPIDelegateHost::write_cmd_addr_data(size_t cmd_bits, uint32_t cmd, size_t addr_bits, uint32_t address,
+                                          const uint8_t *data, size_t length, uint8_t bus_width) {
+  if (bus_width == 0)
+    bus_width = 1;
+  // command and address are always single bit
+  this->simulate_(cmd_bits + addr_bits + (length * 8 + bus_width - 1) / bus_width, (cmd_bits + addr_bits) / 8 + length);
+}
+
+void SPIDelegateHost::queue_transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length,
+                                     SPITransferCallback &&callback) {
+  if (this->queue_.size() == QUEUE_SIZE)
+    this->poll_queued_transfers(true);
+  uint32_t end = this->schedule_(length * 8, length);
+  this->queue_.push_back(
+      {.txbuf = txbuf, .rxbuf = rxbuf, .length = length, .end = end, .callback = std::move(callback)});
+}
+
+void SPIDelegateHost::complete_(QueuedTransfer &transfer) {
+  if (transfer.rxbuf != nullptr && transfer.rxbuf != transfer.txbuf) {
+    if (transfer.txbuf == nullptr) {
+      memset(transfer.rxbuf, 0, transfer.length);
+    } else {
+      memcpy(transfer.rxbuf, transfer.txbuf, transfer.length);
+    }
+  }
+  if (transfer.callback)
+    transfer.callback(true);
+}
+
+size_t SPIDelegateHost::poll_queued_transfers(bool block) {
+  while (!this->queue_.empty()) {
+    uint32_t now = micros();
+    uint32_t end = this->queue_.front().end;
+    if (is_before(now, end)) {
+      if (!block)
+        break;
+      delayMicroseconds(end - now);
+    }
+    block = false;
+    // the callback may queue another transfer
+    QueuedTransfer transfer = std::move(this->queue_.front());
+    this->queue_.pop_front();
+    this->complete_(transfer);
+  }
+  return this->queue_.size();
+}
+
+class SPIBusHost : public SPIBus {
+ public:
+  using SPIBus::SPIBus;
+
+  SPIDelegate *get_delegate(uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin) override {
+    ESP_LOGV(TAG, "Simulating SPI device at %" PRIu32 " Hz", data_rate);
+    return new SPIDelegateHost(data_rate, bit_order, mode, cs_pin);
+  }
+
+  bool is_hw() override { return true; }
+};
+
+SPIBus *SPIComponent::get_bus(SPIInterface interface, GPIOPin *clk, GPIOPin *sdo, GPIOPin *sdi,
+                              const std::vector<uint8_t> &data_pins) {
+  return new SPIBusHost(clk, sdo, sdi);
+}
+
+}  // namespace spi
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,92 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "spi.h"
+#include <deque>
+
+namespace esphome {
+namespace spi {
+
+/// A transfer on the simulated bus, with times in µs from micros().
+struct SPITransferRecord {
+  /// when the transfer was started or queued
+  uint32_t queued;
+  /// when it started on the bus, later than queued when it had to wait for earlier transfers
+  uint32_t start;
+  uint32_t end;
+  size_t length;
+};
+
+/**
+ * Simulated SPI device for the host platform.
+ *
+ * Each transfer takes the time its bits need at the data rate of the device, and the written data is looped back as
+ * the read data. Synchronous transfers block for that time. Queued transfers run on a simulated timeline instead: a
+ * transfer starts once the bus is free and completes when its time has passed, so the caller can do other work in the
+ * meantime, as with DMA on real hardware. The most recent transfers are recorded, to benchmark the frame throughput
+ * of a driver and how well it overlaps preparing data with transmitting it.
+ */
+class SPIDelegateHost : public SPIDelegate {
+ public:
+  /// Transfers that can be queued before queue_transfer() waits for the oldest one.
+  static const size_t QUEUE_SIZE = 4;
+  /// Number of transfers kept in the timeline.
+  static const size_t MAX_RECORDS = 256;
+
+  using SPIDelegate::SPIDelegate;
+
+  void end_transaction() override {
+    this->wait_queued_transfers();
+    SPIDelegate::end_transaction();
+  }
+
+  uint8_t transfer(uint8_t data) override {
+    uint8_t rxbuf;
+    this->transfer(&data, &rxbuf, 1);
+    return rxbuf;
+  }
+  void transfer(uint8_t *ptr, size_t length) override { this->transfer(ptr, ptr, length); }
+  void transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) override;
+  void write(uint16_t data, size_t num_bits) override { this->simulate_(num_bits, (num_bits + 7) / 8); }
+  void write_cmd_addr_data(size_t cmd_bits, uint32_t cmd, size_t addr_bits, uint32_t address, const uint8_t *data,
+                           size_t length, uint8_t bus_width) override;
+  void write_array(const uint8_t *ptr, size_t length) override { this->transfer(ptr, nullptr, length); }
+  void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
+
+  void queue_transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length, SPITransferCallback &&callback) override;
+  size_t poll_queued_transfers(bool block) override;
+
+  /// The most recent transfers, oldest first.
+  const std::deque<SPITransferRecord> &get_records() const { return this->records_; }
+  void clear_records() { this->records_.clear(); }
+  /// Number of bytes transferred since the device was created.
+  uint64_t get_transferred_bytes() const { return this->transferred_bytes_; }
+  /// Time in µs the bus was busy with transfers of this device.
+  uint64_t get_busy_time() const { return this->busy_time_; }
+
+ protected:
+  struct QueuedTransfer {
+    const uint8_t *txbuf;
+    uint8_t *rxbuf;
+    size_t length;
+    uint32_t end;
+    SPITransferCallback callback;
+  };
+
+  /// Put a transfer of the given number of clock cycles on the timeline, after any queued ones. Returns its end.
+  uint32_t schedule_(size_t cycles, size_t length);
+  /// Block for the time of a synchronous transfer.
+  void simulate_(size_t cycles, size_t length);
+  void complete_(QueuedTransfer &transfer);
+
+  std::deque<QueuedTransfer> queue_;
+  std::deque<SPITransferRecord> records_;
+  uint64_t transferred_bytes_{0};
+  uint64_t busy_time_{0};
+};
+
+}  // namespace spi
+}  // namespace esphome
+
+#endif  // USE_HOST
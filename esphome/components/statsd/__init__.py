@@ -15,6 +15,7 @@ DEPENDENCIES = ["network"]
 
 CONF_HOST = "host"
 CONF_PREFIX = "prefix"
+CONF_REFRESH_INTERVAL = "refresh_interval"
 
 statsd_component_ns = cg.esphome_ns.namespace("statsd")
 StatsdComponent = statsd_component_ns.class_("StatsdComponent", cg.PollingComponent)
@@ -39,6 +40,9 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Required(CONF_HOST): cv.string_strict,
         cv.Optional(CONF_PORT, default=8125): cv.port,
         cv.Optional(CONF_PREFIX, default=""): cv.string_strict,
+        cv.Optional(
+            CONF_REFRESH_INTERVAL, default="0s"
+        ): cv.positive_time_period_milliseconds,
         cv.Optional(CONF_SENSORS): cv.ensure_list(CONFIG_SENSORS_SCHEMA),
         cv.Optional(CONF_BINARY_SENSORS): cv.ensure_list(CONFIG_BINARY_SENSORS_SCHEMA),
     }
@@ -55,6 +59,7 @@ async def to_code(config):
             config.get(CONF_PREFIX),
         )
     )
+    cg.add(var.set_refresh_interval(config[CONF_REFRESH_INTERVAL]))
 
     for sensor_cfg in config.get(CONF_SENSORS, []):
         s = await cg.get_variable(sensor_cfg[CONF_ID])
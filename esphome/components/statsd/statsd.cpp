@@ -1,17 +1,24 @@
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
 #include "statsd.h"
 
+#include <cinttypes>
+#include <cmath>
+
 #ifdef USE_NETWORK
 namespace esphome {
 namespace statsd {
 
-// send UDP packet if we reach 1Kb packed size
-// this is needed since statsD does not support fragmented UDP packets
-static const uint16_t SEND_THRESHOLD = 1024;
+// largest UDP packet, as statsD does not support fragmented UDP packets.
+// This is the size recommended by statsD for an Ethernet MTU of 1500 bytes.
+static const size_t MAX_PACKET_SIZE = 1432;
 
 static const char *const TAG = "statsD";
 
+StatsdComponent::StatsdComponent() : packer_(MAX_PACKET_SIZE) {}
+
 void StatsdComponent::setup() {
 #ifndef USE_ESP8266
   this->sock_ = esphome::socket::socket(AF_INET, SOCK_DGRAM, 0);
@@ -44,6 +51,9 @@ void StatsdComponent::dump_config() {
   if (this->prefix_) {
     ESP_LOGCONFIG(TAG, "  prefix: %s", this->prefix_);
   }
+  if (this->refresh_interval_ != 0) {
+    ESP_LOGCONFIG(TAG, "  refresh interval: %" PRIu32 " ms", this->refresh_interval_);
+  }
 
   ESP_LOGCONFIG(TAG, "  metrics:");
   for (sensors_t s : this->sensors_) {
@@ -60,6 +70,7 @@ void StatsdComponent::register_sensor(const char *name, esphome::sensor::Sensor
   s.name = name;
   s.sensor = sensor;
   s.type = TYPE_SENSOR;
+  s.sent = false;
   this->sensors_.push_back(s);
 }
 #endif
@@ -70,15 +81,24 @@ void StatsdComponent::register_binary_sensor(const char *name, esphome::binary_s
   s.name = name;
   s.binary_sensor = binary_sensor;
   s.type = TYPE_BINARY_SENSOR;
+  s.sent = false;
   this->sensors_.push_back(s);
 }
 #endif
 
 void StatsdComponent::update() {
-  std::string out;
-  out.reserve(SEND_THRESHOLD);
+  // Gauges keep their value in statsD, so only changed values need to be sent, apart from a refresh now and then
+  // in case packets got lost.
+  uint32_t now = millis();
+  bool refresh =
+      this->refresh_interval_ == 0 || !this->refreshed_ || now - this->last_refresh_ >= this->refresh_interval_;
+  if (refresh) {
+    this->last_refresh_ = now;
+    this->refreshed_ = true;
+  }
 
-  for (sensors_t s : this->sensors_) {
+  this->packer_.clear();
+  for (sensors_t &s : this->sensors_) {
     double val = 0;
     switch (s.type) {
 #ifdef USE_SENSOR
@@ -105,50 +125,77 @@ void StatsdComponent::update() {
         continue;
     }
 
-    // statsD gauge:
-    // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
-    // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
-    if (val < 0) {
-      if (this->prefix_) {
-        out.append(str_sprintf("%s.", this->prefix_));
-      }
-      out.append(str_sprintf("%s:0|g\n", s.name));
+    bool changed = !s.sent || (val != s.last_value && !(std::isnan(val) && std::isnan(s.last_value)));
+    if (!refresh && !changed) {
+      continue;
     }
+    s.last_value = val;
+    s.sent = true;
+    this->add_metric_(s.name, val);
+  }
+  this->packer_.finish();
+
+  this->send_();
+}
+
+void StatsdComponent::add_metric_(const char *name, double val) {
+  char buf[32];
+  this->record_.clear();
+  // statsD gauge:
+  // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
+  // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
+  // Both lines go into the same record, so that they end up in the same packet.
+  for (int pass = val < 0 ? 0 : 1; pass != 2; pass++) {
     if (this->prefix_) {
-      out.append(str_sprintf("%s.", this->prefix_));
+      this->record_ += this->prefix_;
+      this->record_ += '.';
     }
-    out.append(str_sprintf("%s:%f|g\n", s.name, val));
-
-    if (out.length() > SEND_THRESHOLD) {
-      this->send_(&out);
-      out.clear();
+    this->record_ += name;
+    if (pass == 0) {
+      this->record_ += ":0|g\n";
+    } else {
+      int len = snprintf(buf, sizeof(buf), ":%f|g\n", val);
+      if (len >= 0 && static_cast<size_t>(len) < sizeof(buf)) {
+        this->record_ += buf;
+      } else {
+        // %f prints every digit before the decimal point, which doesn't fit for huge values
+        this->record_ += str_sprintf(":%f|g\n", val);
+      }
     }
   }
-
-  this->send_(&out);
+  if (!this->packer_.add(this->record_.data(), this->record_.size())) {
+    ESP_LOGW(TAG, "Metric %s does not fit into a packet", name);
+  }
 }
 
-void StatsdComponent::send_(std::string *out) {
-  if (out->empty()) {
+void StatsdComponent::send_() {
+  size_t count = this->packer_.get_count();
+  if (count == 0) {
     return;
   }
 #ifdef USE_ESP8266
   IPAddress ip;
   ip.fromString(this->host_);
 
-  this->sock_.beginPacket(ip, this->port_);
-  this->sock_.write((const uint8_t *) out->c_str(), out->length());
-  this->sock_.endPacket();
+  for (size_t i = 0; i != count; i++) {
+    this->sock_.beginPacket(ip, this->port_);
+    this->sock_.write(this->packer_.get_data(i), this->packer_.get_size(i));
+    this->sock_.endPacket();
+  }
 
 #else
   if (!this->sock_) {
     return;
   }
 
-  int n_bytes = this->sock_->sendto(out->c_str(), out->length(), 0, reinterpret_cast<sockaddr *>(&this->destination_),
-                                    sizeof(this->destination_));
-  if (n_bytes != out->length()) {
-    ESP_LOGE(TAG, "Failed to send UDP packed (%d of %d)", n_bytes, out->length());
+  std::vector<socket::Datagram> datagrams(count);
+  for (size_t i = 0; i != count; i++) {
+    datagrams[i] = {this->packer_.get_data(i), this->packer_.get_size(i),
+                    reinterpret_cast<sockaddr *>(&this->destination_), sizeof(this->destination_)};
+  }
+  int sent = this->sock_->sendto_multiple(datagrams.data(), count, 0);
+  if (sent != (int) count) {
+    ESP_LOGE(TAG, "Failed to send UDP packets (%d of %zu)", sent, count);
   }
 #endif
 }
@@ -6,6 +6,7 @@
 #ifdef USE_NETWORK
 #include "esphome/core/component.h"
 #include "esphome/components/socket/socket.h"
+#include "esphome/components/socket/datagram_packer.h"
 #include "esphome/components/network/ip_address.h"
 
 #ifdef USE_SENSOR
@@ -41,10 +42,14 @@ using sensors_t = struct {
     esphome::binary_sensor::BinarySensor *binary_sensor;
 #endif
   };
+  /// Value in the last update that sent it.
+  double last_value;
+  bool sent;
 };
 
 class StatsdComponent : public PollingComponent {
  public:
+  StatsdComponent();
   ~StatsdComponent();
 
   void setup() override;
@@ -57,6 +62,8 @@ class StatsdComponent : public PollingComponent {
     this->port_ = port;
     this->prefix_ = prefix;
   }
+  /// Interval in ms to send all values at; in between, updates only send the values that changed. 0 sends all always.
+  void set_refresh_interval(uint32_t refresh_interval) { this->refresh_interval_ = refresh_interval; }
 
 #ifdef USE_SENSOR
   void register_sensor(const char *name, esphome::sensor::Sensor *sensor);
@@ -70,8 +77,14 @@ class StatsdComponent : public PollingComponent {
   const char *host_;
   const char *prefix_;
   uint16_t port_;
+  uint32_t refresh_interval_{0};
+  uint32_t last_refresh_{0};
+  bool refreshed_{false};
 
   std::vector<sensors_t> sensors_;
+  socket::DatagramPacker packer_;
+  /// The metric being added to the packets.
+  std::string record_;
 
 #ifdef USE_ESP8266
   WiFiUDP sock_;
@@ -80,7 +93,8 @@ class StatsdComponent : public PollingComponent {
   struct sockaddr_in destination_;
 #endif
 
-  void send_(std::string *out);
+  void add_metric_(const char *name, double val);
+  void send_();
 };
 
 }  // namespace statsd
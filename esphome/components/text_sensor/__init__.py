@@ -22,7 +22,7 @@ from esphome.const import (
 )
 from esphome.core import CORE, coroutine_with_priority
 from esphome.cpp_generator import MockObjClass
-from esphome.cpp_helpers import setup_entity
+from esphome.cpp_helpers import register_platform_entity, setup_entity
 from esphome.util import Registry
 
 DEVICE_CLASSES = [
@@ -220,6 +220,7 @@ async def register_text_sensor(var, config):
     if not CORE.has_id(config[CONF_ID]):
         var = cg.Pvariable(config[CONF_ID], var)
     cg.add(cg.App.register_text_sensor(var))
+    register_platform_entity("text_sensor", config)
     await setup_text_sensor_core_(var, config)
 
 
@@ -2,6 +2,7 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 namespace esphome {
@@ -10,6 +11,8 @@ namespace time {
 static const char *const TAG = "automation";
 static const int MAX_TIMESTAMP_DRIFT = 900;  // how far can the clock drift before we consider
                                              // there has been a drastic time synchronization
+static const time_t MAX_CRON_WAIT = 86400;  // re-check at least daily, longer timeouts don't fit the scheduler
+static const uint16_t MAX_CRON_SEARCH_DAYS = 366 * 28;  // every day/weekday/month combination repeats within 28 years
 
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
@@ -21,45 +24,160 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
+optional<time_t> CronTrigger::next_match(time_t after) {
+  if (this->seconds_.none() || this->minutes_.none() || this->hours_.none() || this->days_of_month_.none() ||
+      this->months_.none() || this->days_of_week_.none())
+    return {};
+
+  ESPTime start = ESPTime::from_epoch_local(after + 1);
+  uint16_t year = start.year;
+  uint8_t month = start.month;
+  uint8_t day = start.day_of_month;
+  uint8_t day_of_week = start.day_of_week;
+  uint8_t hour = start.hour;
+  uint8_t minute = start.minute;
+  uint8_t second = std::min<uint8_t>(start.second, 59);
 
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
-    } else if (time > *this->last_check_ && time.timestamp - this->last_check_->timestamp > MAX_TIMESTAMP_DRIFT) {
-      // We went ahead in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped ahead!");
-      this->last_check_ = time;
-      return;
+  // Advance field by field, carrying into the next larger field whenever a field has no match left.
+  uint16_t days_searched = 0;
+  auto next_day = [&]() {
+    days_searched++;
+    day_of_week = day_of_week % 7 + 1;
+    hour = minute = second = 0;
+    if (++day > days_in_month(month, year)) {
+      day = 1;
+      if (++month > 12) {
+        month = 1;
+        year++;
+      }
+    }
+  };
+  while (days_searched < MAX_CRON_SEARCH_DAYS) {
+    if (!this->months_[month]) {
+      // Skip the rest of this month at once
+      uint8_t remaining = days_in_month(month, year) - day;
+      days_searched += remaining;
+      day_of_week = (day_of_week - 1 + remaining) % 7 + 1;
+      day = days_in_month(month, year);
+      next_day();
+      continue;
+    }
+    if (!this->days_of_month_[day] || !this->days_of_week_[day_of_week]) {
+      next_day();
+      continue;
     }
 
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
+    while (hour < 24 && !this->hours_[hour]) {
+      hour++;
+      minute = second = 0;
+    }
+    if (hour == 24) {
+      next_day();
+      continue;
+    }
+    while (minute < 60 && !this->minutes_[minute]) {
+      minute++;
+      second = 0;
+    }
+    if (minute == 60) {
+      hour++;
+      minute = second = 0;
+      if (hour == 24)
+        next_day();
+      continue;
+    }
+    while (second < 60 && !this->seconds_[second])
+      second++;
+    if (second == 60) {
+      minute++;
+      second = 0;
+      continue;
+    }
 
-      if (this->matches(*this->last_check_))
-        this->trigger();
+    // A local time can occur twice when DST ends, so try both offsets and take the earliest one. Local times that
+    // don't exist (skipped when DST starts) are normalized by mktime and won't match anymore.
+    optional<time_t> found;
+    for (int is_dst : {-1, 0, 1}) {
+      struct tm c_tm {};
+      c_tm.tm_year = year - 1900;
+      c_tm.tm_mon = month - 1;
+      c_tm.tm_mday = day;
+      c_tm.tm_hour = hour;
+      c_tm.tm_min = minute;
+      c_tm.tm_sec = second;
+      c_tm.tm_isdst = is_dst;
+      time_t timestamp = ::mktime(&c_tm);
+      if (timestamp > after && (!found.has_value() || timestamp < *found) &&
+          this->matches(ESPTime::from_epoch_local(timestamp)))
+        found = timestamp;
+    }
+    if (found.has_value())
+      return found;
+    second++;
+    if (second == 60) {
+      minute++;
+      second = 0;
     }
   }
+  return {};
+}
+void CronTrigger::setup() {
+  this->rtc_->add_on_time_sync_callback([this]() { this->check_(); });
+  this->check_();
+}
+void CronTrigger::loop() {
+  if (this->rtc_->timestamp_now() >= this->next_fire_)
+    this->check_();
+}
+void CronTrigger::check_() {
+  ESPTime time = this->rtc_->now();
+  if (!time.is_valid()) {
+    // Wait for the time to become valid; most clocks also report this through the time sync callback
+    this->disable_loop();
+    this->set_timeout("check", 1000, [this]() { this->check_(); });
+    return;
+  }
 
-  this->last_check_ = time;
-  if (!time.fields_in_range()) {
-    ESP_LOGW(TAG, "Time is out of range!");
-    ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
-             time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year, time.month,
-             (int64_t) time.timestamp);
+  if (!this->last_check_.has_value()) {
+    this->last_check_ = time.timestamp - 1;
+  } else if (*this->last_check_ > time.timestamp && *this->last_check_ - time.timestamp > MAX_TIMESTAMP_DRIFT) {
+    // We went back in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped back!");
+    this->last_check_ = time.timestamp - 1;
+  } else if (time.timestamp > *this->last_check_ && time.timestamp - *this->last_check_ > MAX_TIMESTAMP_DRIFT) {
+    // We went ahead in time (a lot), probably caused by time synchronization
+    ESP_LOGW(TAG, "Time has jumped ahead!");
+    this->last_check_ = time.timestamp;
   }
 
-  if (this->matches(time))
+  // Catch up on all matches since the last check (e.g. after a small clock adjustment)
+  optional<time_t> next = this->next_match(*this->last_check_);
+  while (next.has_value() && *next <= time.timestamp) {
+    this->last_check_ = *next;
     this->trigger();
+    next = this->next_match(*this->last_check_);
+  }
+  if (time.timestamp > *this->last_check_)
+    this->last_check_ = time.timestamp;
+
+  if (!next.has_value()) {
+    ESP_LOGW(TAG, "Cron expression never matches!");
+    this->disable_loop();
+    this->cancel_timeout("check");
+    return;
+  }
+
+  // The sub-second phase of the clock is unknown, so wake up during the second before the match and poll from there
+  this->next_fire_ = *next;
+  time_t wait = *next - time.timestamp;
+  if (wait > 1) {
+    this->disable_loop();
+    uint32_t timeout = std::min<time_t>(wait - 1, MAX_CRON_WAIT) * 1000;
+    this->set_timeout("check", timeout, [this]() { this->check_(); });
+  } else {
+    this->cancel_timeout("check");
+    this->enable_loop();
+  }
 }
 CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
@@ -27,10 +27,16 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
+  /// Find the first local time strictly after the given UTC epoch that matches this expression.
+  optional<time_t> next_match(time_t after);
+  void setup() override;
   void loop() override;
   float get_setup_priority() const override;
 
  protected:
+  /// Fire all matches up to now and schedule a wakeup shortly before the next one.
+  void check_();
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -38,7 +44,10 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
+  /// Last second (UTC epoch) that has been checked for a match.
+  optional<time_t> last_check_;
+  /// Next matching second (UTC epoch), polled in loop() during the second before it.
+  time_t next_fire_{0};
 };
 
 class SyncTrigger : public Trigger<>, public Component {
@@ -14,8 +14,11 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <algorithm>
 
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
@@ -101,8 +104,16 @@ namespace uart {
 
 static const char *const TAG = "uart.host";
 
+/// Smallest ring buffer for incoming data, so a tiny rx_buffer_size doesn't turn into a read per byte.
+static const size_t MIN_RX_BUFFER_SIZE = 64;
+/// How long reads wait for missing data and writes wait for the port to accept data.
+static const uint32_t READ_TIMEOUT_MS = 100;
+static const uint32_t WRITE_TIMEOUT_MS = 1000;
+
 HostUartComponent::~HostUartComponent() {
   if (this->file_descriptor_ != -1) {
+    if (this->read_fd_registered_)
+      App.unregister_read_fd(this->file_descriptor_);
     close(this->file_descriptor_);
     this->file_descriptor_ = -1;
   }
@@ -116,13 +127,14 @@ void HostUartComponent::setup() {
     this->mark_failed();
     return;
   }
-  this->file_descriptor_ = ::open(this->port_name_.c_str(), O_RDWR | O_NOCTTY | O_NDELAY);
+  this->file_descriptor_ = ::open(this->port_name_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
   if (this->file_descriptor_ == -1) {
     this->update_error_(strerror(errno));
     this->mark_failed();
     return;
   }
-  fcntl(this->file_descriptor_, F_SETFL, 0);
+  this->rx_capacity_ = std::max(this->rx_buffer_size_, MIN_RX_BUFFER_SIZE);
+  this->rx_buffer_ = make_unique<uint8_t[]>(this->rx_capacity_);
   struct termios options;
   tcgetattr(this->file_descriptor_, &options);
   options.c_cflag &= ~CRTSCTS;
@@ -176,6 +188,12 @@ void HostUartComponent::setup() {
   cfsetispeed(&options, baud);
   cfsetospeed(&options, baud);
   tcsetattr(this->file_descriptor_, TCSANOW, &options);
+  this->update_read_fd_registration_();
+}
+
+void HostUartComponent::loop() {
+  if (this->file_descriptor_ != -1)
+    this->fill_rx_buffer_();
 }
 
 void HostUartComponent::dump_config() {
@@ -196,6 +214,7 @@ void HostUartComponent::dump_config() {
                 : this->parity_ == UART_CONFIG_PARITY_EVEN ? "Even"
                                                            : "Odd");
   ESP_LOGCONFIG(TAG, "  Stop Bits: %d", this->stop_bits_);
+  ESP_LOGCONFIG(TAG, "  RX Buffer Size: %zu", this->rx_capacity_);
   this->check_logger_conflict();
 }
 
@@ -203,8 +222,23 @@ void HostUartComponent::write_array(const uint8_t *data, size_t len) {
   if (this->file_descriptor_ == -1) {
     return;
   }
-  size_t written = ::write(this->file_descriptor_, data, len);
-  if (written != len) {
+  size_t written = 0;
+  while (written < len) {
+    ssize_t res = ::write(this->file_descriptor_, data + written, len - written);
+    if (res > 0) {
+      written += res;
+      continue;
+    }
+    if (res == -1 && errno == EINTR)
+      continue;
+    if (res == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // the output buffer of the port is full, wait until it has room again
+      struct pollfd pfd = {.fd = this->file_descriptor_, .events = POLLOUT, .revents = 0};
+      if (::poll(&pfd, 1, WRITE_TIMEOUT_MS) > 0)
+        continue;
+      this->update_error_("Write timed out");
+      return;
+    }
     this->update_error_(strerror(errno));
     return;
   }
@@ -220,17 +254,10 @@ bool HostUartComponent::peek_byte(uint8_t *data) {
   if (this->file_descriptor_ == -1) {
     return false;
   }
-  if (!this->has_peek_) {
-    if (!this->check_read_timeout_()) {
-      return false;
-    }
-    if (::read(this->file_descriptor_, &this->peek_byte_, 1) != 1) {
-      this->update_error_(strerror(errno));
-      return false;
-    }
-    this->has_peek_ = true;
+  if (!this->wait_for_rx_(1)) {
+    return false;
   }
-  *data = this->peek_byte_;
+  *data = this->rx_buffer_[this->rx_head_];
   return true;
 }
 
@@ -238,22 +265,20 @@ bool HostUartComponent::read_array(uint8_t *data, size_t len) {
   if ((this->file_descriptor_ == -1) || (len == 0)) {
     return false;
   }
-  if (!this->check_read_timeout_(len))
+  if (!this->wait_for_rx_(len))
     return false;
-  uint8_t *data_ptr = data;
-  size_t length_to_read = len;
-  if (this->has_peek_) {
-    length_to_read--;
-    *data_ptr = this->peek_byte_;
-    data_ptr++;
-    this->has_peek_ = false;
-  }
-  if (length_to_read > 0) {
-    int sz = ::read(this->file_descriptor_, data_ptr, length_to_read);
-    if (sz == -1) {
-      this->update_error_(strerror(errno));
-      return false;
+  size_t copied = this->take_rx_buffer_(data, len);
+  // reads larger than the ring buffer continue straight from the port, wait_for_rx_() made sure the data is there
+  while (copied < len) {
+    ssize_t res = ::read(this->file_descriptor_, data + copied, len - copied);
+    if (res > 0) {
+      copied += res;
+      continue;
     }
+    if (res == -1 && errno == EINTR)
+      continue;
+    this->update_error_(res == 0 ? "Port closed" : strerror(errno));
+    return false;
   }
 #ifdef USE_UART_DEBUGGER
   for (size_t i = 0; i < len; i++) {
@@ -267,22 +292,111 @@ int HostUartComponent::available() {
   if (this->file_descriptor_ == -1) {
     return 0;
   }
-  int available;
-  int res = ioctl(this->file_descriptor_, FIONREAD, &available);
-  if (res == -1) {
+  // Only go to the port once the buffer ran empty, so draining it byte by byte doesn't cost a system call per byte.
+  // loop() refills the buffer as well.
+  if (this->rx_count_ == 0)
+    this->fill_rx_buffer_();
+  if (this->rx_count_ < this->rx_capacity_)
+    return this->rx_count_;
+  // the ring buffer is full, count the data still waiting in the port as well
+  int pending;
+  if (ioctl(this->file_descriptor_, FIONREAD, &pending) == -1) {
     this->update_error_(strerror(errno));
-    return 0;
+    return this->rx_count_;
   }
-  if (this->has_peek_)
-    available++;
-  return available;
+  return this->rx_count_ + pending;
 };
 
+bool HostUartComponent::wait_for_rx_(size_t len) {
+  if (this->rx_count_ >= len)
+    return true;
+  uint32_t start_time = millis();
+  while (true) {
+    if (!this->fill_rx_buffer_())
+      return false;
+    if (this->rx_count_ >= len)
+      return true;
+    if (this->rx_count_ == this->rx_capacity_ && this->available() >= int(len))
+      return true;
+    uint32_t elapsed = millis() - start_time;
+    if (elapsed >= READ_TIMEOUT_MS) {
+      ESP_LOGE(TAG, "Reading from UART timed out at byte %zu!", this->rx_count_);
+      return false;
+    }
+    struct pollfd pfd = {.fd = this->file_descriptor_, .events = POLLIN, .revents = 0};
+    ::poll(&pfd, 1, READ_TIMEOUT_MS - elapsed);
+  }
+}
+
+bool HostUartComponent::fill_rx_buffer_() {
+  while (this->rx_count_ < this->rx_capacity_) {
+    // the free space of the ring buffer is at most two regions, fill both with a single call
+    size_t tail = (this->rx_head_ + this->rx_count_) % this->rx_capacity_;
+    struct iovec iov[2];
+    int iovcnt = 1;
+    iov[0].iov_base = &this->rx_buffer_[tail];
+    if (tail >= this->rx_head_) {
+      iov[0].iov_len = this->rx_capacity_ - tail;
+      if (this->rx_head_ > 0) {
+        iov[1].iov_base = &this->rx_buffer_[0];
+        iov[1].iov_len = this->rx_head_;
+        iovcnt = 2;
+      }
+    } else {
+      iov[0].iov_len = this->rx_head_ - tail;
+    }
+    size_t free = this->rx_capacity_ - this->rx_count_;
+    ssize_t res = ::readv(this->file_descriptor_, iov, iovcnt);
+    if (res > 0) {
+      this->rx_count_ += res;
+      if (size_t(res) < free)
+        break;  // the port has been drained
+      continue;
+    }
+    if (res == -1 && errno == EINTR)
+      continue;
+    if (res == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+      break;
+    this->update_error_(strerror(errno));
+    return false;
+  }
+  this->update_read_fd_registration_();
+  return true;
+}
+
+size_t HostUartComponent::take_rx_buffer_(uint8_t *data, size_t len) {
+  size_t count = std::min(len, this->rx_count_);
+  size_t first = std::min(count, this->rx_capacity_ - this->rx_head_);
+  memcpy(data, &this->rx_buffer_[this->rx_head_], first);
+  memcpy(data + first, &this->rx_buffer_[0], count - first);
+  this->rx_count_ -= count;
+  // restart at the beginning once empty so the next fill is a single contiguous read
+  this->rx_head_ = this->rx_count_ == 0 ? 0 : (this->rx_head_ + count) % this->rx_capacity_;
+  this->update_read_fd_registration_();
+  return count;
+}
+
+void HostUartComponent::update_read_fd_registration_() {
+  // stop waking up the main loop while there's no room for the data
+  bool has_room = this->rx_count_ < this->rx_capacity_;
+  if (has_room == this->read_fd_registered_)
+    return;
+  if (has_room) {
+    App.register_read_fd(this->file_descriptor_);
+  } else {
+    App.unregister_read_fd(this->file_descriptor_);
+  }
+  this->read_fd_registered_ = has_room;
+}
+
 void HostUartComponent::flush() {
   if (this->file_descriptor_ == -1) {
     return;
   }
   tcflush(this->file_descriptor_, TCIOFLUSH);
+  this->rx_head_ = 0;
+  this->rx_count_ = 0;
+  this->update_read_fd_registration_();
   ESP_LOGV(TAG, "    Flushing...");
 }
 
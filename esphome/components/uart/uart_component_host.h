@@ -2,6 +2,7 @@
 
 #ifdef USE_HOST
 
+#include <memory>
 #include "esphome/core/component.h"
 #include "esphome/core/log.h"
 #include "uart_component.h"
@@ -9,10 +10,17 @@
 namespace esphome {
 namespace uart {
 
+/** UART on a serial port of the host.
+ *
+ * The port is opened non-blocking. Incoming data is read in bulk into a ring buffer of rx_buffer_size bytes, from
+ * loop() and whenever a reader runs out of buffered data, and the port is registered with the main loop so that it
+ * wakes up as soon as data arrives.
+ */
 class HostUartComponent : public UARTComponent, public Component {
  public:
   virtual ~HostUartComponent();
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
   void write_array(const uint8_t *data, size_t len) override;
@@ -25,11 +33,24 @@ class HostUartComponent : public UARTComponent, public Component {
  protected:
   void update_error_(const std::string &error);
   void check_logger_conflict() override {}
+  /// Read everything that fits from the port into the ring buffer, returns false on errors.
+  bool fill_rx_buffer_();
+  /// Copy up to len bytes from the ring buffer to data and remove them, returns the number of bytes copied.
+  size_t take_rx_buffer_(uint8_t *data, size_t len);
+  /// Wait up to the read timeout until len bytes can be read, sleeping until the port becomes readable.
+  bool wait_for_rx_(size_t len);
+  /// Register or unregister the port with the main loop, depending on whether the ring buffer has room.
+  void update_read_fd_registration_();
   std::string port_name_;
   std::string first_error_{""};
   int file_descriptor_ = -1;
-  bool has_peek_{false};
-  uint8_t peek_byte_;
+  std::unique_ptr<uint8_t[]> rx_buffer_;
+  size_t rx_capacity_{0};
+  /// Position of the oldest byte in the ring buffer.
+  size_t rx_head_{0};
+  /// Number of bytes in the ring buffer.
+  size_t rx_count_{0};
+  bool read_fd_registered_{false};
 };
 
 }  // namespace uart
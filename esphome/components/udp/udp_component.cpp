@@ -151,6 +151,8 @@ static void add(std::vector<uint8_t> &vec, const char *str) {
   }
 }
 
+UDPComponent::UDPComponent() : packer_(MAX_PACKET_SIZE) {}
+
 void UDPComponent::setup() {
   this->name_ = App.get_name().c_str();
   if (strlen(this->name_) > 255) {
@@ -196,6 +198,13 @@ void UDPComponent::setup() {
   // pad to a multiple of 4 bytes
   while (this->header_.size() & 0x3)
     this->header_.push_back(0);
+  // every data packet starts with the header and the keys, then as many sensor values as fit
+  this->packer_.set_begin_callback([this]() {
+    this->packer_.append(this->header_.data(), this->header_.size());
+    this->init_data_();
+    this->packer_.append(this->data_.data(), this->data_.size());
+  });
+  this->packer_.set_finish_callback([this](uint8_t *data, size_t &len) { this->finish_data_(data, len); });
 #if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
   for (const auto &address : this->addresses_) {
     struct sockaddr saddr {};
@@ -290,31 +299,21 @@ void UDPComponent::init_data_() {
   }
 }
 
-void UDPComponent::flush_() {
-  if (!network::is_connected() || this->data_.empty())
-    return;
-  uint32_t buffer[MAX_PACKET_SIZE / 4];
-  memset(buffer, 0, sizeof buffer);
-  // len must be a multiple of 4
-  auto header_len = round4(this->header_.size()) / 4;
-  auto len = round4(data_.size()) / 4;
-  memcpy(buffer, this->header_.data(), this->header_.size());
-  memcpy(buffer + header_len, this->data_.data(), this->data_.size());
+void UDPComponent::finish_data_(uint8_t *data, size_t &len) {
+  // The header is already a multiple of 4 bytes; the data after it is padded with zeros (ZERO_FILL_KEY) as well.
+  auto header_len = this->header_.size();
+  len = round4(len);
   if (this->is_encrypted_()) {
-    xxtea_encrypt(buffer + header_len, len, (uint32_t *) this->encryption_key_.data());
+    xxtea_encrypt((uint32_t *) (data + header_len), (len - header_len) / 4, (uint32_t *) this->encryption_key_.data());
   }
-  auto total_len = (header_len + len) * 4;
-  this->send_packet_(buffer, total_len);
 }
 
 void UDPComponent::add_binary_data_(uint8_t key, const char *id, bool data) {
-  auto len = 1 + 1 + 1 + strlen(id);
-  if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
-    this->flush_();
-  }
-  add(this->data_, key);
-  add(this->data_, (uint8_t) data);
-  add(this->data_, id);
+  this->record_.clear();
+  add(this->record_, key);
+  add(this->record_, (uint8_t) data);
+  add(this->record_, id);
+  this->packer_.add(this->record_.data(), this->record_.size());
 }
 void UDPComponent::add_data_(uint8_t key, const char *id, float data) {
   FuData udata{.f32 = data};
@@ -322,18 +321,16 @@ void UDPComponent::add_data_(uint8_t key, const char *id, float data) {
 }
 
 void UDPComponent::add_data_(uint8_t key, const char *id, uint32_t data) {
-  auto len = 4 + 1 + 1 + strlen(id);
-  if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
-    this->flush_();
-  }
-  add(this->data_, key);
-  add(this->data_, data);
-  add(this->data_, id);
+  this->record_.clear();
+  add(this->record_, key);
+  add(this->record_, data);
+  add(this->record_, id);
+  this->packer_.add(this->record_.data(), this->record_.size());
 }
 void UDPComponent::send_data_(bool all) {
   if (!this->should_send_ || !network::is_connected())
     return;
-  this->init_data_();
+  this->packer_.clear();
 #ifdef USE_SENSOR
   for (auto &sensor : this->sensors_) {
     if (all || sensor.updated) {
@@ -350,7 +347,8 @@ void UDPComponent::send_data_(bool all) {
     }
   }
 #endif
-  this->flush_();
+  this->packer_.finish();
+  this->send_packets_();
   this->updated_ = false;
   this->resend_data_ = false;
 }
@@ -603,6 +601,26 @@ void UDPComponent::send_packet_(void *data, size_t len) {
 #endif
 }
 
+void UDPComponent::send_packets_() {
+  size_t count = this->packer_.get_count();
+  if (count == 0)
+    return;
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+  std::vector<socket::Datagram> datagrams(count);
+  for (const auto &saddr : this->sockaddrs_) {
+    for (size_t i = 0; i != count; i++)
+      datagrams[i] = {this->packer_.get_data(i), this->packer_.get_size(i), &saddr, sizeof(saddr)};
+    auto result = this->broadcast_socket_->sendto_multiple(datagrams.data(), count, 0);
+    if (result < (int) count)
+      ESP_LOGW(TAG, "sendto() error %d", errno);
+  }
+#endif
+#ifdef USE_SOCKET_IMPL_LWIP_TCP
+  for (size_t i = 0; i != count; i++)
+    this->send_packet_(const_cast<uint8_t *>(this->packer_.get_data(i)), this->packer_.get_size(i));
+#endif
+}
+
 void UDPComponent::send_ping_pong_request_() {
   if (!this->ping_pong_enable_ || !network::is_connected())
     return;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/components/socket/datagram_packer.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -42,6 +43,8 @@ struct BinarySensor {
 
 class UDPComponent : public PollingComponent {
  public:
+  UDPComponent();
+
   void setup() override;
   void loop() override;
   void update() override;
@@ -100,7 +103,8 @@ class UDPComponent : public PollingComponent {
  protected:
   void send_data_(bool all);
   void process_(uint8_t *buf, size_t len);
-  void flush_();
+  /// Complete a data packet: pad it and encrypt it if a key is set.
+  void finish_data_(uint8_t *data, size_t &len);
   void add_data_(uint8_t key, const char *id, float data);
   void add_data_(uint8_t key, const char *id, uint32_t data);
   void increment_code_();
@@ -147,10 +151,15 @@ class UDPComponent : public PollingComponent {
   std::vector<uint8_t> ping_header_{};
   std::vector<uint8_t> header_{};
   std::vector<uint8_t> data_{};
+  /// A sensor value being added to the data packets.
+  std::vector<uint8_t> record_{};
+  socket::DatagramPacker packer_;
   std::map<const char *, uint32_t> ping_keys_{};
   void add_key_(const char *name, uint32_t key);
   void send_ping_pong_request_();
   void send_packet_(void *data, size_t len);
+  /// Send all packets in the packer to all addresses.
+  void send_packets_();
   void process_ping_request_(const char *name, uint8_t *ptr, size_t len);
 
   inline bool is_encrypted_() { return !this->encryption_key_.empty(); }
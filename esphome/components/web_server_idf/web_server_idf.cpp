@@ -22,6 +22,9 @@ namespace web_server_idf {
 
 static const char *const TAG = "web_server_idf";
 
+/// Size of the chunks that chunked responses are sent in.
+static const size_t CHUNK_SIZE = 512;
+
 void AsyncWebServer::end() {
   if (this->server_) {
     httpd_stop(this->server_);
@@ -147,9 +150,7 @@ std::string AsyncWebServerRequest::url() const {
 
 std::string AsyncWebServerRequest::host() const { return this->get_header("Host").value(); }
 
-void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
-  httpd_resp_send(*this, response->get_content_data(), response->get_content_size());
-}
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) { response->send_content(*this); }
 
 void AsyncWebServerRequest::send(int code, const char *content_type, const char *content) {
   this->init_response_(nullptr, code, content_type);
@@ -185,6 +186,21 @@ void AsyncWebServerRequest::init_response_(AsyncWebServerResponse *rsp, int code
   this->rsp_ = rsp;
 }
 
+esp_err_t AsyncWebServerResponseChunked::send_content(httpd_req_t *req) {
+  uint8_t buffer[CHUNK_SIZE];
+  size_t index = 0;
+  while (true) {
+    size_t len = this->filler_(buffer, sizeof(buffer), index);
+    if (len == 0)
+      break;
+    esp_err_t err = httpd_resp_send_chunk(req, reinterpret_cast<const char *>(buffer), len);
+    if (err != ESP_OK)
+      return err;
+    index += len;
+  }
+  return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
 bool AsyncWebServerRequest::authenticate(const char *username, const char *password) const {
   if (username == nullptr || password == nullptr || *username == 0) {
     return true;
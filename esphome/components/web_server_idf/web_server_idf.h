@@ -29,6 +29,9 @@ class AsyncWebParameter {
 
 class AsyncWebServerRequest;
 
+/// Produces the content of a chunked response: fills up to max_len bytes from offset index, returns 0 at the end.
+using AwsResponseFiller = std::function<size_t(uint8_t *buffer, size_t max_len, size_t index)>;
+
 class AsyncWebServerResponse {
  public:
   AsyncWebServerResponse(const AsyncWebServerRequest *req) : req_(req) {}
@@ -40,6 +43,11 @@ class AsyncWebServerResponse {
   virtual const char *get_content_data() const = 0;
   virtual size_t get_content_size() const = 0;
 
+  /// Send the content to the client.
+  virtual esp_err_t send_content(httpd_req_t *req) {
+    return httpd_resp_send(req, this->get_content_data(), this->get_content_size());
+  }
+
  protected:
   const AsyncWebServerRequest *req_;
 };
@@ -93,6 +101,20 @@ class AsyncWebServerResponseProgmem : public AsyncWebServerResponse {
   size_t size_;
 };
 
+class AsyncWebServerResponseChunked : public AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponseChunked(const AsyncWebServerRequest *req, AwsResponseFiller filler)
+      : AsyncWebServerResponse(req), filler_(std::move(filler)) {}
+
+  const char *get_content_data() const override { return nullptr; };
+  size_t get_content_size() const override { return 0; };
+
+  esp_err_t send_content(httpd_req_t *req) override;
+
+ protected:
+  AwsResponseFiller filler_;
+};
+
 class AsyncWebServerRequest {
   friend class AsyncWebServer;
 
@@ -139,6 +161,13 @@ class AsyncWebServerRequest {
     return res;
   }
 
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  AsyncWebServerResponse *beginChunkedResponse(const char *content_type, AwsResponseFiller filler) {
+    auto *res = new AsyncWebServerResponseChunked(this, std::move(filler));  // NOLINT(cppcoreguidelines-owning-memory)
+    this->init_response_(res, 200, content_type);
+    return res;
+  }
+
   // NOLINTNEXTLINE(readability-identifier-naming)
   bool hasParam(const std::string &name) { return this->getParam(name) != nullptr; }
   // NOLINTNEXTLINE(readability-identifier-naming)
@@ -525,6 +525,10 @@ class EsphomeCore:
         self.loaded_integrations = set()
         # A set of component IDs to track what Component subclasses are declared
         self.component_ids = set()
+        # Number of components and entities (by platform, e.g. "sensor") registered with the Application
+        self.platform_counts: dict[str, int] = {}
+        # Object id hashes of the registered entities by platform, None if only known at runtime
+        self.platform_object_id_hashes: dict[str, list[Optional[int]]] = {}
         # Whether ESPHome was started in verbose mode
         self.verbose = False
         # Whether ESPHome was started in quiet mode
@@ -552,6 +556,8 @@ class EsphomeCore:
         self.platformio_options = {}
         self.loaded_integrations = set()
         self.component_ids = set()
+        self.platform_counts = {}
+        self.platform_object_id_hashes = {}
         PIN_SCHEMA_REGISTRY.reset()
 
     @property
@@ -685,7 +691,7 @@ class EsphomeCore:
         except RuntimeError as e:
             raise EsphomeError(str(e)) from e
 
-    def add(self, expression):
+    def add(self, expression, prepend: bool = False):
         from esphome.cpp_generator import Expression, Statement, statement
 
         if isinstance(expression, Expression):
@@ -695,10 +701,17 @@ class EsphomeCore:
                 f"Add '{expression}' must be expression or statement, not {type(expression)}"
             )
 
-        self.main_statements.append(expression)
+        if prepend:
+            self.main_statements.insert(0, expression)
+        else:
+            self.main_statements.append(expression)
         _LOGGER.debug("Adding: %s", expression)
         return expression
 
+    def register_platform_component(self, platform_name: str) -> None:
+        """Count a component or entity registered with the Application, so storage can be reserved up front."""
+        self.platform_counts[platform_name] = self.platform_counts.get(platform_name, 0) + 1
+
     def add_global(self, expression):
         from esphome.cpp_generator import Expression, Statement, statement
 
@@ -17,12 +17,8 @@ void Application::register_component_(Component *comp) {
     return;
   }
 
-  for (auto *c : this->components_) {
-    if (comp == c) {
-      ESP_LOGW(TAG, "Component %s already registered! (%p)", c->get_component_source(), c);
-      return;
-    }
-  }
+  // Not checked for duplicates to keep boot O(n): cpp_helpers.register_component refuses an ID twice, and components
+  // registered by CustomComponentConstructor are not registered again by its codegen
   this->components_.push_back(comp);
 }
 void Application::setup() {
@@ -35,6 +31,8 @@ void Application::setup() {
   for (uint32_t i = 0; i < this->components_.size(); i++) {
     Component *component = this->components_[i];
 
+    // components already run during setup, e.g. a light transition started on boot
+    this->loop_component_start_time_ = millis();
     component->call();
     this->scheduler.process_to_add();
     this->feed_wdt();
@@ -48,6 +46,7 @@ void Application::setup() {
       uint32_t new_app_state = STATUS_LED_WARNING;
       this->scheduler.call();
       this->feed_wdt();
+      this->loop_component_start_time_ = millis();
       for (uint32_t j = 0; j <= i; j++) {
         this->components_[j]->call();
         new_app_state |= this->components_[j]->get_component_state();
@@ -68,7 +67,11 @@ void Application::loop() {
 
   this->scheduler.call();
   this->feed_wdt();
-  for (Component *component : this->looping_components_) {
+  this->loop_component_start_time_ = millis();
+  this->in_loop_ = true;
+  for (this->current_loop_index_ = 0; this->current_loop_index_ < this->looping_components_active_end_;
+       this->current_loop_index_++) {
+    Component *component = this->looping_components_[this->current_loop_index_];
     {
       WarnIfComponentBlockingGuard guard{component};
       component->call();
@@ -77,6 +80,7 @@ void Application::loop() {
     this->app_state_ |= new_app_state;
     this->feed_wdt();
   }
+  this->in_loop_ = false;
   this->app_state_ = new_app_state;
 
   const uint32_t now = millis();
@@ -91,7 +95,11 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_HOST
+    this->wait_for_read_fds_(delay_time);
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -108,6 +116,34 @@ void Application::loop() {
   }
 }
 
+#ifdef USE_HOST
+void Application::register_read_fd(int fd) {
+  for (auto &pfd : this->read_fds_) {
+    if (pfd.fd == fd)
+      return;
+  }
+  this->read_fds_.push_back({.fd = fd, .events = POLLIN, .revents = 0});
+}
+
+void Application::unregister_read_fd(int fd) {
+  for (auto it = this->read_fds_.begin(); it != this->read_fds_.end(); ++it) {
+    if (it->fd == fd) {
+      this->read_fds_.erase(it);
+      return;
+    }
+  }
+}
+
+void Application::wait_for_read_fds_(uint32_t timeout_ms) {
+  if (this->read_fds_.empty()) {
+    delay(timeout_ms);
+    return;
+  }
+  // An interrupted wait just ends the idle time early
+  ::poll(this->read_fds_.data(), this->read_fds_.size(), timeout_ms);
+}
+#endif
+
 void IRAM_ATTR HOT Application::feed_wdt() {
   static uint32_t last_feed = 0;
   uint32_t now = micros();
@@ -144,10 +180,55 @@ void Application::run_safe_shutdown_hooks() {
 }
 
 void Application::calculate_looping_components_() {
-  for (auto *obj : this->components_) {
-    if (obj->has_overridden_loop())
+  // Components that already disabled their loop during setup() are placed after the active ones
+  for (bool disabled : {false, true}) {
+    if (disabled)
+      this->looping_components_active_end_ = this->looping_components_.size();
+    for (auto *obj : this->components_) {
+      bool loop_done = (obj->get_component_state() & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE;
+      if (!obj->has_overridden_loop() || loop_done != disabled)
+        continue;
+      obj->loop_index_ = this->looping_components_.size();
       this->looping_components_.push_back(obj);
+    }
+  }
+}
+
+void Application::swap_looping_components_(uint16_t a, uint16_t b) {
+  if (a == b)
+    return;
+  std::swap(this->looping_components_[a], this->looping_components_[b]);
+  this->looping_components_[a]->loop_index_ = a;
+  this->looping_components_[b]->loop_index_ = b;
+}
+
+void Application::disable_component_loop_(Component *component) {
+  uint16_t index = component->loop_index_;
+  // Not (yet) in the active list, e.g. called during setup() or for a component without loop()
+  if (index >= this->looping_components_active_end_ || this->looping_components_[index] != component)
+    return;
+
+  uint16_t last = this->looping_components_active_end_ - 1;
+  if (this->in_loop_ && index <= this->current_loop_index_) {
+    // The component already ran in this iteration: move it to the current position first, so that the
+    // not yet called component swapped in from the end is still called in this iteration.
+    this->swap_looping_components_(index, this->current_loop_index_);
+    this->swap_looping_components_(this->current_loop_index_, last);
+    this->current_loop_index_--;
+  } else {
+    this->swap_looping_components_(index, last);
   }
+  this->looping_components_active_end_--;
+}
+
+void Application::enable_component_loop_(Component *component) {
+  uint16_t index = component->loop_index_;
+  if (index < this->looping_components_active_end_ || index >= this->looping_components_.size() ||
+      this->looping_components_[index] != component)
+    return;
+
+  this->swap_looping_components_(index, this->looping_components_active_end_);
+  this->looping_components_active_end_++;
 }
 
 Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -9,6 +9,10 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_HOST
+#include <poll.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -75,6 +79,18 @@
 
 namespace esphome {
 
+/** Perfect hash table from object id hash to position in one of the entity registries of the Application.
+ *
+ * Generated by the code generator for every platform whose object ids are all known at compile time. A key is
+ * mapped to its slot with `(key * multiplier) >> (32 - bits)`.
+ */
+struct EntityKeyTable {
+  const uint16_t *slots;  ///< Position in the registry + 1 for every slot, 0 for empty slots.
+  uint32_t multiplier;
+  uint8_t bits;
+  uint16_t count;  ///< Number of entities the table was generated for.
+};
+
 class Application {
  public:
   void pre_setup(const std::string &name, const std::string &friendly_name, const std::string &area,
@@ -101,90 +117,177 @@ class Application {
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
     this->binary_sensors_.push_back(binary_sensor);
   }
+  void reserve_binary_sensor(size_t count) { this->binary_sensors_.reserve(count); }
+  void set_binary_sensor_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->binary_sensor_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_SENSOR
   void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void reserve_sensor(size_t count) { this->sensors_.reserve(count); }
+  void set_sensor_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->sensor_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_SWITCH
   void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void reserve_switch(size_t count) { this->switches_.reserve(count); }
+  void set_switch_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->switch_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_BUTTON
   void register_button(button::Button *button) { this->buttons_.push_back(button); }
+  void reserve_button(size_t count) { this->buttons_.reserve(count); }
+  void set_button_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->button_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
   void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void reserve_text_sensor(size_t count) { this->text_sensors_.reserve(count); }
+  void set_text_sensor_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->text_sensor_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_FAN
   void register_fan(fan::Fan *state) { this->fans_.push_back(state); }
+  void reserve_fan(size_t count) { this->fans_.reserve(count); }
+  void set_fan_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->fan_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_COVER
   void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void reserve_cover(size_t count) { this->covers_.reserve(count); }
+  void set_cover_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->cover_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_CLIMATE
   void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void reserve_climate(size_t count) { this->climates_.reserve(count); }
+  void set_climate_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->climate_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_LIGHT
   void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void reserve_light(size_t count) { this->lights_.reserve(count); }
+  void set_light_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->light_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_NUMBER
   void register_number(number::Number *number) { this->numbers_.push_back(number); }
+  void reserve_number(size_t count) { this->numbers_.reserve(count); }
+  void set_number_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->number_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_DATETIME_DATE
   void register_date(datetime::DateEntity *date) { this->dates_.push_back(date); }
+  void reserve_date(size_t count) { this->dates_.reserve(count); }
+  void set_date_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->date_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_DATETIME_TIME
   void register_time(datetime::TimeEntity *time) { this->times_.push_back(time); }
+  void reserve_time(size_t count) { this->times_.reserve(count); }
+  void set_time_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->time_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_DATETIME_DATETIME
   void register_datetime(datetime::DateTimeEntity *datetime) { this->datetimes_.push_back(datetime); }
+  void reserve_datetime(size_t count) { this->datetimes_.reserve(count); }
+  void set_datetime_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->datetime_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_TEXT
   void register_text(text::Text *text) { this->texts_.push_back(text); }
+  void reserve_text(size_t count) { this->texts_.reserve(count); }
+  void set_text_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->text_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_SELECT
   void register_select(select::Select *select) { this->selects_.push_back(select); }
+  void reserve_select(size_t count) { this->selects_.reserve(count); }
+  void set_select_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->select_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_LOCK
   void register_lock(lock::Lock *a_lock) { this->locks_.push_back(a_lock); }
+  void reserve_lock(size_t count) { this->locks_.reserve(count); }
+  void set_lock_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->lock_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_VALVE
   void register_valve(valve::Valve *valve) { this->valves_.push_back(valve); }
+  void reserve_valve(size_t count) { this->valves_.reserve(count); }
+  void set_valve_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->valve_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_MEDIA_PLAYER
   void register_media_player(media_player::MediaPlayer *media_player) { this->media_players_.push_back(media_player); }
+  void reserve_media_player(size_t count) { this->media_players_.reserve(count); }
+  void set_media_player_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->media_player_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
   void register_alarm_control_panel(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
     this->alarm_control_panels_.push_back(a_alarm_control_panel);
   }
+  void reserve_alarm_control_panel(size_t count) { this->alarm_control_panels_.reserve(count); }
+  void set_alarm_control_panel_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->alarm_control_panel_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_EVENT
   void register_event(event::Event *event) { this->events_.push_back(event); }
+  void reserve_event(size_t count) { this->events_.reserve(count); }
+  void set_event_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->event_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
 #ifdef USE_UPDATE
   void register_update(update::UpdateEntity *update) { this->updates_.push_back(update); }
+  void reserve_update(size_t count) { this->updates_.reserve(count); }
+  void set_update_key_table(const uint16_t *slots, uint32_t multiplier, uint8_t bits, uint16_t count) {
+    this->update_key_table_ = {slots, multiplier, bits, count};
+  }
 #endif
 
+  /// Reserve storage for the given number of components, called by the generated code before registering them.
+  void reserve_components(size_t count) { this->components_.reserve(count); }
+
   /// Register the component in this Application instance.
   template<class C> C *register_component(C *c) {
     static_assert(std::is_base_of<Component, C>::value, "Only Component subclasses can be registered");
@@ -231,6 +334,26 @@ class Application {
 
   uint32_t get_loop_interval() const { return this->loop_interval_; }
 
+  /** Return the time in milliseconds at which the current pass over the components' loop() methods started.
+   *
+   * This includes the passes setup() makes while it waits for a component, and the setup() call of each component.
+   *
+   * Components that animate over time can use this instead of millis() so that everything running in the same pass,
+   * like several lights sharing a transition, acts on the same point in time.
+   */
+  uint32_t get_loop_component_start_time() const { return this->loop_component_start_time_; }
+
+#ifdef USE_HOST
+  /** Wake up the main loop from its idle wait as soon as the file descriptor becomes readable.
+   *
+   * Components reading from serial ports, pipes or sockets can use this to handle incoming data right away instead
+   * of at the next loop interval. The component must consume the data in its loop(), otherwise the main loop keeps
+   * waking up; unregister the file descriptor while the data can't be consumed.
+   */
+  void register_read_fd(int fd);
+  void unregister_read_fd(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -246,181 +369,109 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->binary_sensors_, this->binary_sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->switches_, this->switch_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->buttons_, this->button_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->sensors_, this->sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->text_sensors_, this->text_sensor_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->fans_, this->fan_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->covers_, this->cover_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->lights_, this->light_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->climates_, this->climate_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->numbers_, this->number_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATE
   const std::vector<datetime::DateEntity *> &get_dates() { return this->dates_; }
   datetime::DateEntity *get_date_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->dates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->dates_, this->date_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_TIME
   const std::vector<datetime::TimeEntity *> &get_times() { return this->times_; }
   datetime::TimeEntity *get_time_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->times_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->times_, this->time_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_DATETIME_DATETIME
   const std::vector<datetime::DateTimeEntity *> &get_datetimes() { return this->datetimes_; }
   datetime::DateTimeEntity *get_datetime_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->datetimes_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->datetimes_, this->datetime_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_TEXT
   const std::vector<text::Text *> &get_texts() { return this->texts_; }
   text::Text *get_text_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->texts_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->texts_, this->text_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->selects_, this->select_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->locks_, this->lock_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_VALVE
   const std::vector<valve::Valve *> &get_valves() { return this->valves_; }
   valve::Valve *get_valve_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->valves_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->valves_, this->valve_key_table_, key, include_internal);
   }
 #endif
 #ifdef USE_MEDIA_PLAYER
   const std::vector<media_player::MediaPlayer *> &get_media_players() { return this->media_players_; }
   media_player::MediaPlayer *get_media_player_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->media_players_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->media_players_, this->media_player_key_table_, key, include_internal);
   }
 #endif
 
@@ -429,33 +480,21 @@ class Application {
     return this->alarm_control_panels_;
   }
   alarm_control_panel::AlarmControlPanel *get_alarm_control_panel_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->alarm_control_panels_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->alarm_control_panels_, this->alarm_control_panel_key_table_, key, include_internal);
   }
 #endif
 
 #ifdef USE_EVENT
   const std::vector<event::Event *> &get_events() { return this->events_; }
   event::Event *get_event_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->events_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->events_, this->event_key_table_, key, include_internal);
   }
 #endif
 
 #ifdef USE_UPDATE
   const std::vector<update::UpdateEntity *> &get_updates() { return this->updates_; }
   update::UpdateEntity *get_update_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->updates_) {
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    }
-    return nullptr;
+    return this->find_entity_by_key_(this->updates_, this->update_key_table_, key, include_internal);
   }
 #endif
 
@@ -468,73 +507,124 @@ class Application {
 
   void calculate_looping_components_();
 
+  void disable_component_loop_(Component *component);
+  void enable_component_loop_(Component *component);
+  void swap_looping_components_(uint16_t a, uint16_t b);
+
   void feed_wdt_arch_();
 
+#ifdef USE_HOST
+  /// Sleep for up to timeout_ms, returning early when one of the registered file descriptors becomes readable.
+  void wait_for_read_fds_(uint32_t timeout_ms);
+#endif
+
+  template<typename T>
+  static T *find_entity_by_key_(const std::vector<T *> &entities, const EntityKeyTable &table, uint32_t key,
+                                bool include_internal) {
+    if (table.slots != nullptr) {
+      uint16_t pos = table.slots[(key * table.multiplier) >> (32 - table.bits)];
+      if (pos != 0 && pos <= entities.size() && entities[pos - 1]->get_object_id_hash() == key) {
+        T *obj = entities[pos - 1];
+        return include_internal || !obj->is_internal() ? obj : nullptr;
+      }
+      // The table covers every registered entity, so this key doesn't exist
+      if (table.count == entities.size())
+        return nullptr;
+    }
+    for (auto *obj : entities) {
+      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
+        return obj;
+    }
+    return nullptr;
+  }
+
   std::vector<Component *> components_{};
+  /// Components with a loop() method. Active ones are in [0, looping_components_active_end_), the rest are disabled.
   std::vector<Component *> looping_components_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
+  EntityKeyTable binary_sensor_key_table_{};
 #endif
 #ifdef USE_SWITCH
   std::vector<switch_::Switch *> switches_{};
+  EntityKeyTable switch_key_table_{};
 #endif
 #ifdef USE_BUTTON
   std::vector<button::Button *> buttons_{};
+  EntityKeyTable button_key_table_{};
 #endif
 #ifdef USE_EVENT
   std::vector<event::Event *> events_{};
+  EntityKeyTable event_key_table_{};
 #endif
 #ifdef USE_SENSOR
   std::vector<sensor::Sensor *> sensors_{};
+  EntityKeyTable sensor_key_table_{};
 #endif
 #ifdef USE_TEXT_SENSOR
   std::vector<text_sensor::TextSensor *> text_sensors_{};
+  EntityKeyTable text_sensor_key_table_{};
 #endif
 #ifdef USE_FAN
   std::vector<fan::Fan *> fans_{};
+  EntityKeyTable fan_key_table_{};
 #endif
 #ifdef USE_COVER
   std::vector<cover::Cover *> covers_{};
+  EntityKeyTable cover_key_table_{};
 #endif
 #ifdef USE_CLIMATE
   std::vector<climate::Climate *> climates_{};
+  EntityKeyTable climate_key_table_{};
 #endif
 #ifdef USE_LIGHT
   std::vector<light::LightState *> lights_{};
+  EntityKeyTable light_key_table_{};
 #endif
 #ifdef USE_NUMBER
   std::vector<number::Number *> numbers_{};
+  EntityKeyTable number_key_table_{};
 #endif
 #ifdef USE_DATETIME_DATE
   std::vector<datetime::DateEntity *> dates_{};
+  EntityKeyTable date_key_table_{};
 #endif
 #ifdef USE_DATETIME_TIME
   std::vector<datetime::TimeEntity *> times_{};
+  EntityKeyTable time_key_table_{};
 #endif
 #ifdef USE_DATETIME_DATETIME
   std::vector<datetime::DateTimeEntity *> datetimes_{};
+  EntityKeyTable datetime_key_table_{};
 #endif
 #ifdef USE_SELECT
   std::vector<select::Select *> selects_{};
+  EntityKeyTable select_key_table_{};
 #endif
 #ifdef USE_TEXT
   std::vector<text::Text *> texts_{};
+  EntityKeyTable text_key_table_{};
 #endif
 #ifdef USE_LOCK
   std::vector<lock::Lock *> locks_{};
+  EntityKeyTable lock_key_table_{};
 #endif
 #ifdef USE_VALVE
   std::vector<valve::Valve *> valves_{};
+  EntityKeyTable valve_key_table_{};
 #endif
 #ifdef USE_MEDIA_PLAYER
   std::vector<media_player::MediaPlayer *> media_players_{};
+  EntityKeyTable media_player_key_table_{};
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   std::vector<alarm_control_panel::AlarmControlPanel *> alarm_control_panels_{};
+  EntityKeyTable alarm_control_panel_key_table_{};
 #endif
 #ifdef USE_UPDATE
   std::vector<update::UpdateEntity *> updates_{};
+  EntityKeyTable update_key_table_{};
 #endif
 
   std::string name_;
@@ -544,9 +634,16 @@ class Application {
   const char *compilation_time_{nullptr};
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
+  uint32_t loop_component_start_time_{0};
   uint32_t loop_interval_{16};
+#ifdef USE_HOST
+  std::vector<struct pollfd> read_fds_{};
+#endif
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+  uint16_t looping_components_active_end_{0};
+  uint16_t current_loop_index_{0};
+  bool in_loop_{false};
 };
 
 /// Global storage of Application pointer - only one Application can exist.
@@ -3,6 +3,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/preferences.h"
 
 #include <vector>
@@ -148,6 +149,12 @@ class ProjectUpdateTrigger : public Trigger<std::string>, public Component {
 };
 #endif
 
+/** Delay the rest of the action list.
+ *
+ * Every concurrent run (e.g. of a parallel or queued script) gets its own slot holding the arguments inline. Slots are
+ * reused once their delay has elapsed, so after the first runs no allocations happen. The slots are checked in loop(),
+ * which is only active while at least one run is waiting.
+ */
 template<typename... Ts> class DelayAction : public Action<Ts...>, public Component {
  public:
   explicit DelayAction() = default;
@@ -155,16 +162,77 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    uint32_t delay = this->delay_.value(x...);
+    if (delay == SCHEDULER_DONT_RUN)
+      return;
+
+    auto &run = this->acquire_run_();
+    run.args = std::make_tuple(x...);
+    run.start = millis();
+    run.delay = delay;
+    run.state = RUN_PENDING;
+    this->enable_loop();
+  }
+
+  void loop() override {
+    const uint32_t now = millis();
+    // Mark the elapsed runs first, so runs started by the next actions are not finished in this same loop
+    for (auto &run : this->runs_) {
+      if (run.state == RUN_PENDING && now - run.start >= run.delay)
+        run.state = RUN_ELAPSED;
+    }
+    // Index based, the next actions may start new runs and grow runs_
+    for (size_t i = 0; i < this->runs_.size(); i++) {
+      if (this->runs_[i].state != RUN_ELAPSED)
+        continue;
+      this->runs_[i].state = RUN_FREE;
+      auto args = std::move(this->runs_[i].args);
+      this->play_next_args_(args, typename gens<sizeof...(Ts)>::type());
+    }
+
+    for (auto &run : this->runs_) {
+      if (run.state != RUN_FREE)
+        return;
+    }
+    this->disable_loop();
   }
+
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    for (auto &run : this->runs_)
+      run.state = RUN_FREE;
+  }
+
+ protected:
+  enum RunState : uint8_t { RUN_FREE, RUN_PENDING, RUN_ELAPSED };
+  struct Run {
+    // Copies of the arguments, as references passed by the trigger don't outlive the call that started the run
+    std::tuple<typename std::decay<Ts>::type...> args;
+    uint32_t start;
+    uint32_t delay;
+    RunState state;
+  };
+
+  template<int... S>
+  void play_next_args_(std::tuple<typename std::decay<Ts>::type...> &args, seq<S...> /*unused*/) {
+    this->play_next_(std::get<S>(args)...);
+  }
+
+  Run &acquire_run_() {
+    for (auto &run : this->runs_) {
+      if (run.state == RUN_FREE)
+        return run;
+    }
+    this->runs_.emplace_back();
+    return this->runs_.back();
+  }
+
+  std::vector<Run> runs_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -328,12 +396,15 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       this->set_timeout("timeout", this->timeout_value_.value(x...), f);
     }
 
+    this->enable_loop();
     this->loop();
   }
 
   void loop() override {
-    if (this->num_running_ == 0)
+    if (this->num_running_ == 0) {
+      this->disable_loop();
       return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
@@ -34,6 +34,7 @@ const uint32_t COMPONENT_STATE_CONSTRUCTION = 0x00;
 const uint32_t COMPONENT_STATE_SETUP = 0x01;
 const uint32_t COMPONENT_STATE_LOOP = 0x02;
 const uint32_t COMPONENT_STATE_FAILED = 0x03;
+const uint32_t COMPONENT_STATE_LOOP_DONE = 0x04;
 const uint32_t STATUS_LED_MASK = 0xFF00;
 const uint32_t STATUS_LED_OK = 0x0000;
 const uint32_t STATUS_LED_WARNING = 0x0100;
@@ -106,6 +107,9 @@ void Component::call() {
     case COMPONENT_STATE_FAILED:  // NOLINT(bugprone-branch-clone)
       // State failed: Do nothing
       break;
+    case COMPONENT_STATE_LOOP_DONE:  // NOLINT(bugprone-branch-clone)
+      // State loop done: Do nothing until enable_loop() is called
+      break;
     default:
       break;
   }
@@ -143,8 +147,24 @@ void Component::set_retry(uint32_t initial_wait_time, uint8_t max_attempts, std:
 bool Component::is_failed() const { return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_FAILED; }
 bool Component::is_ready() const {
   return (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP ||
+         (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_LOOP_DONE ||
          (this->component_state_ & COMPONENT_STATE_MASK) == COMPONENT_STATE_SETUP;
 }
+void Component::disable_loop() {
+  uint32_t state = this->component_state_ & COMPONENT_STATE_MASK;
+  if (state != COMPONENT_STATE_SETUP && state != COMPONENT_STATE_LOOP)
+    return;
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP_DONE;
+  App.disable_component_loop_(this);
+}
+void Component::enable_loop() {
+  if ((this->component_state_ & COMPONENT_STATE_MASK) != COMPONENT_STATE_LOOP_DONE)
+    return;
+  this->component_state_ &= ~COMPONENT_STATE_MASK;
+  this->component_state_ |= COMPONENT_STATE_LOOP;
+  App.enable_component_loop_(this);
+}
 bool Component::can_proceed() { return true; }
 bool Component::status_has_warning() const { return this->component_state_ & STATUS_LED_WARNING; }
 bool Component::status_has_error() const { return this->component_state_ & STATUS_LED_ERROR; }
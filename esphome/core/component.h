@@ -58,6 +58,7 @@ extern const uint32_t COMPONENT_STATE_CONSTRUCTION;
 extern const uint32_t COMPONENT_STATE_SETUP;
 extern const uint32_t COMPONENT_STATE_LOOP;
 extern const uint32_t COMPONENT_STATE_FAILED;
+extern const uint32_t COMPONENT_STATE_LOOP_DONE;
 extern const uint32_t STATUS_LED_MASK;
 extern const uint32_t STATUS_LED_OK;
 extern const uint32_t STATUS_LED_WARNING;
@@ -142,6 +143,17 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components that only need loop() while something is pending (a running transition, a queued action, ...)
+   * should call this when they become idle, so the main loop doesn't have to call them every iteration.
+   * Removal is O(1) and safe to call from within loop() or setup().
+   */
+  void disable_loop();
+
+  /// Resume calling loop() for this component after disable_loop(). Does nothing if loop() is not disabled.
+  void enable_loop();
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -272,6 +284,7 @@ class Component {
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  uint16_t loop_index_{0};  ///< Position in Application::looping_components_, maintained by the Application.
 };
 
 /** This class simplifies creating components that periodically check a state.
@@ -2,6 +2,7 @@ import logging
 import multiprocessing
 import os
 import re
+from typing import Optional
 
 from esphome import automation
 import esphome.codegen as cg
@@ -38,7 +39,7 @@ from esphome.const import (
     TARGET_PLATFORMS,
     __version__ as ESPHOME_VERSION,
 )
-from esphome.core import CORE, coroutine_with_priority
+from esphome.core import CORE, ID, coroutine_with_priority
 from esphome.helpers import copy_file_if_changed, get_str_env, walk_files
 
 _LOGGER = logging.getLogger(__name__)
@@ -326,6 +327,55 @@ async def _add_platformio_options(pio_options):
         cg.add_platformio_option(key, val)
 
 
+@coroutine_with_priority(-1000.0)
+async def _add_platform_reserves():
+    # Runs after everything has been registered, so the Application can size its registries exactly once
+    for platform_name, count in sorted(CORE.platform_counts.items()):
+        cg.add(getattr(cg.App, f"reserve_{platform_name}")(count), prepend=True)
+
+
+def _find_perfect_hash(hashes: list[int]) -> Optional[tuple[int, int, list[int]]]:
+    """Find a multiplicative hash that maps all object id hashes to distinct slots.
+
+    Returns the multiplier, the number of bits of the table index and the slots, which hold the position of the
+    entity in the registry + 1 (0 for empty slots). Returns None if no table of at most 8 slots per entity was found.
+    """
+    min_bits = max(1, (len(hashes) - 1).bit_length() + 1)
+    for bits in range(min_bits, min_bits + 3):
+        multiplier = 0x9E3779B1
+        for _ in range(4096):
+            slots = [0] * (1 << bits)
+            for index, hash_ in enumerate(hashes):
+                slot = ((hash_ * multiplier) & 0xFFFFFFFF) >> (32 - bits)
+                if slots[slot]:
+                    break
+                slots[slot] = index + 1
+            else:
+                return multiplier, bits, slots
+            multiplier = (multiplier + 2) & 0xFFFFFFFF
+    return None
+
+
+@coroutine_with_priority(-1000.0)
+async def _add_entity_key_tables():
+    # Lookup tables for App.get_<platform>_by_key(), only possible when all object ids are known at compile time
+    for platform_name, hashes in sorted(CORE.platform_object_id_hashes.items()):
+        if None in hashes or len(set(hashes)) != len(hashes):
+            continue
+        if (perfect_hash := _find_perfect_hash(hashes)) is None:
+            continue
+        multiplier, bits, slots = perfect_hash
+        slots_arr = cg.static_const_array(
+            ID(f"{platform_name}_key_slots", is_declaration=True, type=cg.uint16),
+            cg.ArrayInitializer(*slots),
+        )
+        cg.add(
+            getattr(cg.App, f"set_{platform_name}_key_table")(
+                slots_arr, multiplier, bits, len(hashes)
+            )
+        )
+
+
 @coroutine_with_priority(30.0)
 async def _add_automations(config):
     for conf in config.get(CONF_ON_BOOT, []):
@@ -406,3 +456,6 @@ async def to_code(config):
 
     if config[CONF_PLATFORMIO_OPTIONS]:
         CORE.add_job(_add_platformio_options, config[CONF_PLATFORMIO_OPTIONS])
+
+    CORE.add_job(_add_platform_reserves)
+    CORE.add_job(_add_entity_key_tables)
@@ -57,6 +57,10 @@ void EntityBase::set_object_id(const char *object_id) {
   this->object_id_c_str_ = object_id;
   this->calc_object_id_();
 }
+void EntityBase::set_object_id(const char *object_id, uint32_t object_id_hash) {
+  this->object_id_c_str_ = object_id;
+  this->object_id_hash_ = object_id_hash;
+}
 
 // Calculate Object ID Hash from Entity Name
 void EntityBase::calc_object_id_() {
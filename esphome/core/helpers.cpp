@@ -180,11 +180,12 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc, uint16_t poly,
   return refout ? (crc ^ 0xffff) : crc;
 }
 
-uint32_t fnv1_hash(const std::string &str) {
+uint32_t fnv1_hash(const std::string &str) { return fnv1_hash(str.data(), str.size()); }
+uint32_t fnv1_hash(const char *data, size_t len) {
   uint32_t hash = 2166136261UL;
-  for (char c : str) {
+  for (size_t i = 0; i < len; i++) {
     hash *= 16777619UL;
-    hash ^= c;
+    hash ^= data[i];
   }
   return hash;
 }
@@ -413,14 +414,17 @@ ParseOnOffState parse_on_off(const char *str, const char *on, const char *off) {
 }
 
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
+  char tmp[32];  // should be enough, but we should maybe improve this at some point.
+  value_accuracy_to_buf(tmp, sizeof(tmp), value, accuracy_decimals);
+  return std::string(tmp);
+}
+int value_accuracy_to_buf(char *buf, size_t buf_len, float value, int8_t accuracy_decimals) {
   if (accuracy_decimals < 0) {
     auto multiplier = powf(10.0f, accuracy_decimals);
     value = roundf(value * multiplier) / multiplier;
     accuracy_decimals = 0;
   }
-  char tmp[32];  // should be enough, but we should maybe improve this at some point.
-  snprintf(tmp, sizeof(tmp), "%.*f", accuracy_decimals, value);
-  return std::string(tmp);
+  return snprintf(buf, buf_len, "%.*f", accuracy_decimals, value);
 }
 
 int8_t step_to_accuracy_decimals(float step) {
@@ -166,6 +166,8 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of \p len bytes at \p data.
+uint32_t fnv1_hash(const char *data, size_t len);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
@@ -432,6 +434,8 @@ ParseOnOffState parse_on_off(const char *str, const char *on = nullptr, const ch
 
 /// Create a string from a value and an accuracy in decimals.
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals);
+/// Format a value with an accuracy in decimals into buf, returns the length like snprintf().
+int value_accuracy_to_buf(char *buf, size_t buf_len, float value, int8_t accuracy_decimals);
 
 /// Derive accuracy in decimals from an increment step.
 int8_t step_to_accuracy_decimals(float step);
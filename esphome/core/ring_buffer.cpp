@@ -3,26 +3,41 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 #ifdef USE_ESP32
+#include <freertos/task.h>
+#endif
 
-#include "helpers.h"
+#ifdef USE_HOST
+#include <chrono>
+#endif
 
 namespace esphome {
 
 static const char *const TAG = "ring_buffer";
 
+#ifdef RING_BUFFER_STREAM_BUFFER
+
+/// Largest span of the stream buffer backend.
+static const size_t STAGING_SIZE = 512;
+
 RingBuffer::~RingBuffer() {
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   if (this->handle_ != nullptr) {
     vStreamBufferDelete(this->handle_);
-    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
     allocator.deallocate(this->storage_, this->size_);
   }
+  if (this->read_staging_ != nullptr)
+    allocator.deallocate(this->read_staging_, 2 * STAGING_SIZE);
 }
 
 std::unique_ptr<RingBuffer> RingBuffer::create(size_t len) {
   std::unique_ptr<RingBuffer> rb = make_unique<RingBuffer>();
 
   rb->size_ = len + 1;
+  rb->capacity_ = len;
 
   ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   rb->storage_ = allocator.allocate(rb->size_);
@@ -35,11 +50,33 @@ std::unique_ptr<RingBuffer> RingBuffer::create(size_t len) {
   return rb;
 }
 
-size_t RingBuffer::read(void *data, size_t len, TickType_t ticks_to_wait) {
+bool RingBuffer::allocate_staging_() {
+  if (this->read_staging_ != nullptr)
+    return true;
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  this->read_staging_ = allocator.allocate(2 * STAGING_SIZE);
+  if (this->read_staging_ == nullptr)
+    return false;
+  this->write_staging_ = this->read_staging_ + STAGING_SIZE;
+  return true;
+}
+
+size_t RingBuffer::read(void *data, size_t len, Ticks ticks_to_wait) {
+  size_t bytes_read = 0;
+  if (this->read_staged_ > 0) {
+    // bytes received for a read span come first
+    bytes_read = std::min(len, this->read_staged_);
+    memcpy(data, this->read_staging_ + this->read_staged_offset_, bytes_read);
+    this->release(bytes_read);
+    if (bytes_read == len)
+      return bytes_read;
+  }
+
   if (ticks_to_wait > 0)
-    xStreamBufferSetTriggerLevel(this->handle_, len);
+    xStreamBufferSetTriggerLevel(this->handle_, len - bytes_read);
 
-  size_t bytes_read = xStreamBufferReceive(this->handle_, data, len, ticks_to_wait);
+  bytes_read += xStreamBufferReceive(this->handle_, static_cast<uint8_t *>(data) + bytes_read, len - bytes_read,
+                                     ticks_to_wait);
 
   xStreamBufferSetTriggerLevel(this->handle_, 1);
 
@@ -56,16 +93,238 @@ size_t RingBuffer::write(const void *data, size_t len) {
   return xStreamBufferSend(this->handle_, data, len, 0);
 }
 
-size_t RingBuffer::write_without_replacement(const void *data, size_t len, TickType_t ticks_to_wait) {
+size_t RingBuffer::write_without_replacement(const void *data, size_t len, Ticks ticks_to_wait) {
   return xStreamBufferSend(this->handle_, data, len, ticks_to_wait);
 }
 
-size_t RingBuffer::available() const { return xStreamBufferBytesAvailable(this->handle_); }
+RingBuffer::ReadSpan RingBuffer::acquire_read_span(size_t len, Ticks ticks_to_wait) {
+  if (this->read_staged_ == 0) {
+    if (!this->allocate_staging_())
+      return {nullptr, 0};
+    this->read_staged_offset_ = 0;
+    this->read_staged_ = this->read(this->read_staging_, std::min(len, STAGING_SIZE), ticks_to_wait);
+  }
+  return {this->read_staging_ + this->read_staged_offset_, std::min(len, this->read_staged_)};
+}
+
+void RingBuffer::release(size_t len) {
+  len = std::min(len, this->read_staged_);
+  this->read_staged_offset_ += len;
+  this->read_staged_ -= len;
+}
+
+RingBuffer::WriteSpan RingBuffer::acquire_write_span(size_t len, Ticks ticks_to_wait) {
+  if (!this->allocate_staging_())
+    return {nullptr, 0};
+  // the stream buffer waits for space when the span is committed
+  this->write_ticks_ = ticks_to_wait;
+  return {this->write_staging_, std::min(len, STAGING_SIZE)};
+}
+
+void RingBuffer::commit(size_t len) {
+  if (len > 0)
+    xStreamBufferSend(this->handle_, this->write_staging_, len, this->write_ticks_);
+}
+
+size_t RingBuffer::available() const { return xStreamBufferBytesAvailable(this->handle_) + this->read_staged_; }
 
 size_t RingBuffer::free() const { return xStreamBufferSpacesAvailable(this->handle_); }
 
-BaseType_t RingBuffer::reset() { return xStreamBufferReset(this->handle_); }
+void RingBuffer::reset() {
+  this->read_staged_ = 0;
+  xStreamBufferReset(this->handle_);
+}
+
+#else
 
-}  // namespace esphome
+RingBuffer::~RingBuffer() {
+  if (this->storage_ != nullptr) {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    allocator.deallocate(this->storage_, this->size_);
+  }
+#ifdef USE_ESP32
+  if (this->data_ready_ != nullptr)
+    vSemaphoreDelete(this->data_ready_);
+  if (this->space_ready_ != nullptr)
+    vSemaphoreDelete(this->space_ready_);
+#endif
+}
+
+std::unique_ptr<RingBuffer> RingBuffer::create(size_t len) {
+  std::unique_ptr<RingBuffer> rb = make_unique<RingBuffer>();
+
+  rb->size_ = len;
+  rb->capacity_ = len;
 
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  rb->storage_ = allocator.allocate(rb->size_);
+  if (rb->storage_ == nullptr) {
+    return nullptr;
+  }
+
+#ifdef USE_ESP32
+  rb->data_ready_ = xSemaphoreCreateBinary();
+  rb->space_ready_ = xSemaphoreCreateBinary();
+  if (rb->data_ready_ == nullptr || rb->space_ready_ == nullptr) {
+    return nullptr;
+  }
 #endif
+
+  ESP_LOGD(TAG, "Created ring buffer with size %zu", len);
+  return rb;
+}
+
+bool RingBuffer::wait_(bool for_data, size_t len, Ticks ticks_to_wait) {
+  len = std::min(len, this->capacity_);
+  auto ready = [this, for_data, len]() { return (for_data ? this->available() : this->free()) >= len; };
+  if (ready())
+    return true;
+  if (ticks_to_wait == 0)
+    return false;
+
+  std::atomic<bool> &waiting = for_data ? this->reader_waiting_ : this->writer_waiting_;
+#if defined(USE_ESP32)
+  SemaphoreHandle_t semaphore = for_data ? this->data_ready_ : this->space_ready_;
+  TimeOut_t timeout;
+  vTaskSetTimeOutState(&timeout);
+  waiting.store(true);
+  // a notification given before the flag was set may still be pending, so the condition is checked after every wake
+  while (!ready() && xTaskCheckForTimeOut(&timeout, &ticks_to_wait) == pdFALSE)
+    xSemaphoreTake(semaphore, ticks_to_wait);
+  waiting.store(false);
+  return ready();
+#elif defined(USE_HOST)
+  std::unique_lock<std::mutex> lock(this->wait_mutex_);
+  waiting.store(true);
+  bool result = true;
+  if (ticks_to_wait == UINT32_MAX) {
+    this->wait_condition_.wait(lock, ready);
+  } else {
+    result = this->wait_condition_.wait_for(lock, std::chrono::milliseconds(ticks_to_wait), ready);
+  }
+  waiting.store(false);
+  return result;
+#else
+  // nothing else runs while waiting
+  (void) waiting;
+  return false;
+#endif
+}
+
+void RingBuffer::notify_(bool for_data) {
+  // the flag is read after the index was stored, so a waiter either sees the new index or is woken
+  if (!(for_data ? this->reader_waiting_ : this->writer_waiting_).load())
+    return;
+#if defined(USE_ESP32)
+  xSemaphoreGive(for_data ? this->data_ready_ : this->space_ready_);
+#elif defined(USE_HOST)
+  {
+    // taking the lock makes sure the waiter is not between checking the condition and sleeping
+    std::lock_guard<std::mutex> lock(this->wait_mutex_);
+  }
+  this->wait_condition_.notify_all();
+#endif
+}
+
+void RingBuffer::discard_(size_t len) {
+  size_t tail = this->tail_.load();
+  size_t next;
+  do {
+    size_t used = this->used_(this->head_.load(), tail);
+    next = this->advance_(tail, std::min(len, used));
+  } while (!this->tail_.compare_exchange_weak(tail, next));
+  this->notify_(false);
+}
+
+size_t RingBuffer::read(void *data, size_t len, Ticks ticks_to_wait) {
+  this->wait_(true, len, ticks_to_wait);
+
+  auto *out = static_cast<uint8_t *>(data);
+  while (true) {
+    size_t tail = this->tail_.load();
+    size_t bytes_read = std::min(len, this->used_(this->head_.load(), tail));
+    size_t offset = this->offset_(tail);
+    size_t first = std::min(bytes_read, this->capacity_ - offset);
+    memcpy(out, this->storage_ + offset, first);
+    memcpy(out + first, this->storage_, bytes_read - first);
+    // fails when the writer overwrote the oldest data while it was copied, then the data is read again
+    if (this->tail_.compare_exchange_strong(tail, this->advance_(tail, bytes_read))) {
+      if (bytes_read > 0)
+        this->notify_(false);
+      return bytes_read;
+    }
+  }
+}
+
+size_t RingBuffer::write(const void *data, size_t len) {
+  const auto *in = static_cast<const uint8_t *>(data);
+  if (len > this->capacity_) {
+    // only the newest data fits
+    in += len - this->capacity_;
+    len = this->capacity_;
+  }
+  size_t free = this->free();
+  if (free < len)
+    this->discard_(len - free);
+  return this->write_without_replacement(in, len);
+}
+
+size_t RingBuffer::write_without_replacement(const void *data, size_t len, Ticks ticks_to_wait) {
+  this->wait_(false, len, ticks_to_wait);
+
+  const auto *in = static_cast<const uint8_t *>(data);
+  size_t head = this->head_.load();
+  size_t bytes_written = std::min(len, this->capacity_ - this->used_(head, this->tail_.load()));
+  size_t offset = this->offset_(head);
+  size_t first = std::min(bytes_written, this->capacity_ - offset);
+  memcpy(this->storage_ + offset, in, first);
+  memcpy(this->storage_, in + first, bytes_written - first);
+  this->commit(bytes_written);
+  return bytes_written;
+}
+
+RingBuffer::ReadSpan RingBuffer::acquire_read_span(size_t len, Ticks ticks_to_wait) {
+  this->wait_(true, len, ticks_to_wait);
+
+  size_t tail = this->tail_.load();
+  size_t offset = this->offset_(tail);
+  size_t span_len = std::min({len, this->used_(this->head_.load(), tail), this->capacity_ - offset});
+  this->span_tail_ = tail;
+  return {this->storage_ + offset, span_len};
+}
+
+void RingBuffer::release(size_t len) {
+  if (len == 0)
+    return;
+  size_t tail = this->span_tail_;
+  // when the writer overwrote the span in the meantime, the data is gone already
+  if (this->tail_.compare_exchange_strong(tail, this->advance_(tail, len)))
+    this->notify_(false);
+}
+
+RingBuffer::WriteSpan RingBuffer::acquire_write_span(size_t len, Ticks ticks_to_wait) {
+  this->wait_(false, len, ticks_to_wait);
+
+  size_t head = this->head_.load();
+  size_t offset = this->offset_(head);
+  size_t span_len =
+      std::min({len, this->capacity_ - this->used_(head, this->tail_.load()), this->capacity_ - offset});
+  return {this->storage_ + offset, span_len};
+}
+
+void RingBuffer::commit(size_t len) {
+  if (len == 0)
+    return;
+  this->head_.store(this->advance_(this->head_.load(), len));
+  this->notify_(true);
+}
+
+size_t RingBuffer::available() const { return this->used_(this->head_.load(), this->tail_.load()); }
+
+size_t RingBuffer::free() const { return this->capacity_ - this->available(); }
+
+void RingBuffer::reset() { this->discard_(this->capacity_); }
+
+#endif
+
+}  // namespace esphome
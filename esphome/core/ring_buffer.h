@@ -1,37 +1,88 @@
 #pragma once
 
-#ifdef USE_ESP32
+#include "esphome/core/defines.h"
 
+#ifdef USE_ESP32
 #include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <freertos/stream_buffer.h>
+#endif
+
+#ifdef USE_HOST
+#include <condition_variable>
+#include <mutex>
+#endif
 
+#include <algorithm>
+#include <atomic>
 #include <cinttypes>
+#include <cstddef>
 #include <memory>
 
+// The FreeRTOS stream buffer backend can be selected with -DUSE_RING_BUFFER_STREAM_BUFFER in the build flags.
+#if defined(USE_ESP32) && defined(USE_RING_BUFFER_STREAM_BUFFER)
+#define RING_BUFFER_STREAM_BUFFER
+#endif
+
 namespace esphome {
 
+/**
+ * A byte ring buffer between one writer and one reader, which may run in different tasks.
+ *
+ * By default it is a lock-free single producer, single consumer buffer that works on every platform. Data is either
+ * copied in and out with write() and read(), or accessed in place: acquire_write_span() returns free space to fill
+ * that commit() passes on to the reader, and acquire_read_span() returns stored data that release() frees again. The
+ * spans are contiguous, so at the end of the storage they can be shorter than what is stored or free, and acquiring
+ * again after release() or commit() returns the rest.
+ *
+ * Waiting for data or space blocks the calling task on ESP32 and the calling thread on the host. Other platforms
+ * have a single thread, so there nothing could arrive while waiting and the calls return right away.
+ *
+ * With the FreeRTOS stream buffer backend the spans are emulated by copying through a small staging buffer.
+ */
 class RingBuffer {
  public:
+#ifdef USE_ESP32
+  /// Time to wait, in FreeRTOS ticks.
+  using Ticks = TickType_t;
+#else
+  /// Time to wait, in milliseconds.
+  using Ticks = uint32_t;
+#endif
+
+  /// Stored data that can be read in place.
+  struct ReadSpan {
+    const uint8_t *data;
+    size_t len;
+  };
+
+  /// Free space that can be written in place.
+  struct WriteSpan {
+    uint8_t *data;
+    size_t len;
+  };
+
   ~RingBuffer();
 
   /**
    * @brief Reads from the ring buffer, waiting up to a specified number of ticks if necessary.
    *
    * Available bytes are read into the provided data pointer. If not enough bytes are available,
-   * the function will wait up to `ticks_to_wait` FreeRTOS ticks before reading what is available.
+   * the function will wait up to `ticks_to_wait` ticks before reading what is available.
    *
    * @param data Pointer to copy read data into
    * @param len Number of bytes to read
-   * @param ticks_to_wait Maximum number of FreeRTOS ticks to wait (default: 0)
+   * @param ticks_to_wait Maximum number of ticks to wait (default: 0)
    * @return Number of bytes read
    */
-  size_t read(void *data, size_t len, TickType_t ticks_to_wait = 0);
+  size_t read(void *data, size_t len, Ticks ticks_to_wait = 0);
 
   /**
    * @brief Writes to the ring buffer, overwriting oldest data if necessary.
    *
    * The provided data is written to the ring buffer. If not enough space is available,
-   * the function will overwrite the oldest data in the ring buffer.
+   * the function will overwrite the oldest data in the ring buffer. Data of a read span
+   * that is being held can be overwritten as well, so the reader should copy with read().
    *
    * @param data Pointer to data for writing
    * @param len Number of bytes to write
@@ -43,20 +94,58 @@ class RingBuffer {
    * @brief Writes to the ring buffer without overwriting oldest data.
    *
    * The provided data is written to the ring buffer. If not enough space is available,
-   * the function will wait up to `ticks_to_wait` FreeRTOS ticks before writing as much as possible.
+   * the function will wait up to `ticks_to_wait` ticks before writing as much as possible.
    *
    * @param data Pointer to data for writing
    * @param len Number of bytes to write
-   * @param ticks_to_wait Maximum number of FreeRTOS ticks to wait (default: 0)
+   * @param ticks_to_wait Maximum number of ticks to wait (default: 0)
    * @return Number of bytes written
    */
-  size_t write_without_replacement(const void *data, size_t len, TickType_t ticks_to_wait = 0);
+  size_t write_without_replacement(const void *data, size_t len, Ticks ticks_to_wait = 0);
+
+  /**
+   * @brief Returns stored data to read in place, without copying it.
+   *
+   * If less than `len` bytes are stored, the function will wait up to `ticks_to_wait` ticks for more.
+   * The data stays valid until it is released, and only the reader may call this.
+   *
+   * @param len Largest number of bytes to return
+   * @param ticks_to_wait Maximum number of ticks to wait (default: 0)
+   * @return The data, with a length of 0 if nothing is stored
+   */
+  ReadSpan acquire_read_span(size_t len, Ticks ticks_to_wait = 0);
+
+  /**
+   * @brief Frees the first bytes of the last acquired read span.
+   *
+   * @param len Number of bytes that were consumed, at most the length of the span
+   */
+  void release(size_t len);
+
+  /**
+   * @brief Returns free space to write in place, without copying the data.
+   *
+   * If less than `len` bytes are free, the function will wait up to `ticks_to_wait` ticks for more.
+   * Nothing is stored until the written bytes are committed, and only the writer may call this.
+   *
+   * @param len Largest number of bytes to return
+   * @param ticks_to_wait Maximum number of ticks to wait (default: 0)
+   * @return The space, with a length of 0 if the ring buffer is full
+   */
+  WriteSpan acquire_write_span(size_t len, Ticks ticks_to_wait = 0);
+
+  /**
+   * @brief Stores the first bytes of the last acquired write span, making them available to the reader.
+   *
+   * @param len Number of bytes that were written, at most the length of the span
+   */
+  void commit(size_t len);
 
   /**
    * @brief Returns the number of available bytes in the ring buffer.
    *
    * This function provides the number of bytes that can be read from the ring buffer
-   * without blocking the calling FreeRTOS task.
+   * without blocking the calling task.
    *
    * @return Number of available bytes
    */
@@ -66,28 +155,73 @@ class RingBuffer {
    * @brief Returns the number of free bytes in the ring buffer.
    *
    * This function provides the number of bytes that can be written to the ring buffer
-   * without overwriting data or blocking the calling FreeRTOS task.
+   * without overwriting data or blocking the calling task.
    *
    * @return Number of free bytes
    */
   size_t free() const;
 
+  /// Returns the number of bytes the ring buffer can hold.
+  size_t capacity() const { return this->capacity_; }
+
   /**
    * @brief Resets the ring buffer, discarding all stored data.
-   *
-   * @return pdPASS if successful, pdFAIL otherwise
    */
-  BaseType_t reset();
+  void reset();
 
   static std::unique_ptr<RingBuffer> create(size_t len);
 
  protected:
-  StreamBufferHandle_t handle_;
+#ifdef RING_BUFFER_STREAM_BUFFER
+  /// Allocates the buffer the spans are staged in.
+  bool allocate_staging_();
+
+  StreamBufferHandle_t handle_{nullptr};
   StaticStreamBuffer_t structure_;
-  uint8_t *storage_;
+  /// Bytes that were received from the stream buffer for a read span, but not yet released.
+  uint8_t *read_staging_{nullptr};
+  size_t read_staged_offset_{0};
+  size_t read_staged_{0};
+  uint8_t *write_staging_{nullptr};
+  Ticks write_ticks_{0};
+#else
+  /// Moves an index forward. Indices run up to twice the capacity, which tells a full buffer from an empty one.
+  size_t advance_(size_t index, size_t len) const {
+    index += len;
+    return index >= 2 * this->capacity_ ? index - 2 * this->capacity_ : index;
+  }
+  size_t offset_(size_t index) const { return index >= this->capacity_ ? index - this->capacity_ : index; }
+  /// Bytes between the indices. Indices read while the writer overwrites data can be inconsistent, so it is clamped.
+  size_t used_(size_t head, size_t tail) const {
+    return std::min(head >= tail ? head - tail : head + 2 * this->capacity_ - tail, this->capacity_);
+  }
+  /// Drops up to len of the oldest bytes, from either side.
+  void discard_(size_t len);
+  /// Waits until at least len bytes are available, or free if for_data is false.
+  bool wait_(bool for_data, size_t len, Ticks ticks_to_wait);
+  /// Wakes a reader or writer waiting for data or space.
+  void notify_(bool for_data);
+
+  /// Index the writer stores the next byte at, only changed by the writer.
+  std::atomic<size_t> head_{0};
+  /// Index of the oldest byte. The reader advances it, and the writer when it overwrites or resets.
+  std::atomic<size_t> tail_{0};
+  /// The tail when the last read span was acquired.
+  size_t span_tail_{0};
+  std::atomic<bool> reader_waiting_{false};
+  std::atomic<bool> writer_waiting_{false};
+#ifdef USE_ESP32
+  SemaphoreHandle_t data_ready_{nullptr};
+  SemaphoreHandle_t space_ready_{nullptr};
+#endif
+#ifdef USE_HOST
+  std::mutex wait_mutex_;
+  std::condition_variable wait_condition_;
+#endif
+#endif
+  uint8_t *storage_{nullptr};
   size_t size_{0};
+  size_t capacity_{0};
 };
 
 }  // namespace esphome
-
-#endif
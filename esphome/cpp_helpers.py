@@ -1,8 +1,10 @@
 import logging
+from typing import Optional
 
 from esphome.const import (
     CONF_DISABLED_BY_DEFAULT,
     CONF_ENTITY_CATEGORY,
+    CONF_ESPHOME,
     CONF_ICON,
     CONF_INTERNAL,
     CONF_NAME,
@@ -16,7 +18,7 @@ from esphome.core import CORE, ID, coroutine
 from esphome.coroutine import FakeAwaitable
 from esphome.cpp_generator import add, get_variable
 from esphome.cpp_types import App
-from esphome.helpers import sanitize, snake_case
+from esphome.helpers import fnv1_hash, sanitize, snake_case
 from esphome.types import ConfigFragmentType, ConfigType
 from esphome.util import Registry, RegistryEntry
 
@@ -85,6 +87,7 @@ async def register_component(var, config):
         add(var.set_component_source(name))
 
     add(App.register_component(var))
+    CORE.register_platform_component("components")
     return var
 
 
@@ -96,13 +99,44 @@ async def register_parented(var, value):
     add(var.set_parent(paren))
 
 
+def get_object_id(config: ConfigType) -> str:
+    """Get the object id of an Entity, same as `EntityBase::get_object_id`."""
+    if not config[CONF_NAME]:
+        return sanitize(snake_case(CORE.friendly_name))
+    return sanitize(snake_case(config[CONF_NAME]))
+
+
+def get_object_id_hash(config: ConfigType) -> Optional[int]:
+    """Get the object id hash of an Entity, or None if it is only known at runtime.
+
+    Entities without a name use the friendly name, which gets the MAC address appended with name_add_mac_suffix.
+    """
+    if not config[CONF_NAME]:
+        esphome_config = (CORE.config or {}).get(CONF_ESPHOME, {})
+        if esphome_config.get("name_add_mac_suffix", False):
+            return None
+    return fnv1_hash(get_object_id(config))
+
+
+def register_platform_entity(platform_name: str, config: ConfigType) -> None:
+    """Count an entity registered with App.register_<platform_name>() and remember its object id hash.
+
+    Must be called in the same order as the register calls are generated.
+    """
+    CORE.register_platform_component(platform_name)
+    CORE.platform_object_id_hashes.setdefault(platform_name, []).append(
+        get_object_id_hash(config)
+    )
+
+
 async def setup_entity(var, config):
     """Set up generic properties of an Entity"""
     add(var.set_name(config[CONF_NAME]))
-    if not config[CONF_NAME]:
-        add(var.set_object_id(sanitize(snake_case(CORE.friendly_name))))
+    object_id_hash = get_object_id_hash(config)
+    if object_id_hash is None:
+        add(var.set_object_id(get_object_id(config)))
     else:
-        add(var.set_object_id(sanitize(snake_case(config[CONF_NAME]))))
+        add(var.set_object_id(get_object_id(config), object_id_hash))
     add(var.set_disabled_by_default(config[CONF_DISABLED_BY_DEFAULT]))
     if CONF_INTERNAL in config:
         add(var.set_internal(config[CONF_INTERNAL]))
@@ -414,6 +414,15 @@ def snake_case(value):
     return value.replace(" ", "_").lower()
 
 
+def fnv1_hash(value):
+    """Same behaviour as `helpers.cpp` method `fnv1_hash`."""
+    hash_ = 2166136261
+    for char in value.encode():
+        hash_ = (hash_ * 16777619) & 0xFFFFFFFF
+        hash_ ^= char
+    return hash_
+
+
 _DISALLOWED_CHARS = re.compile(r"[^a-zA-Z0-9-_]")
 
 
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Replay captured UART traffic into a pseudo terminal for the host platform.
+
+Creates a PTY pair and prints the path of its device side. Use that path as the `port:` of a `uart:` in a host
+configuration, then the captured bytes are written to it, paced at the line rate of the given baud rate. With
+`--baud 0` the data is written as fast as the device reads it, which measures the throughput of its parsers.
+Anything the device writes back is counted and discarded.
+"""
+
+import argparse
+import fcntl
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+
+def load_capture(path: str, is_hex: bool) -> bytes:
+    with open(path, "rb") as f:
+        data = f.read()
+    if is_hex:
+        return bytes.fromhex(data.decode("ascii"))
+    return data
+
+
+def wait_until_read(slave: int, timeout: float) -> None:
+    """Wait until the device has read everything written to the PTY, closing it earlier would drop the rest."""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        pending = struct.unpack("i", fcntl.ioctl(slave, termios.FIONREAD, b"\0\0\0\0"))[0]
+        if pending == 0:
+            return
+        time.sleep(0.01)
+
+
+def replay(
+    master: int, slave: int, data: bytes, baud: int, bits_per_byte: int, chunk_size: int
+) -> tuple[int, int, float]:
+    sent = received = 0
+    start = time.monotonic()
+    while sent < len(data):
+        if baud > 0:
+            # bytes the line could have carried by now
+            due = int((time.monotonic() - start) * baud / bits_per_byte)
+            if due <= sent:
+                time.sleep(min(chunk_size, len(data) - sent) * bits_per_byte / baud)
+                continue
+            end = min(due, sent + chunk_size, len(data))
+        else:
+            end = min(sent + chunk_size, len(data))
+        readable, writable, _ = select.select([master], [master], [], 1.0)
+        if readable:
+            received += len(os.read(master, 4096))
+        if writable:
+            sent += os.write(master, data[sent:end])
+    if baud == 0:
+        # without pacing the time only means something once the device has read everything
+        wait_until_read(slave, 60.0)
+    return sent, received, time.monotonic() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("capture", help="file with the captured bytes")
+    parser.add_argument("--hex", action="store_true", help="the capture is a hex dump instead of raw bytes")
+    parser.add_argument("--baud", type=int, default=9600, help="baud rate to pace the replay at, 0 for no pacing")
+    parser.add_argument("--bits-per-byte", type=int, default=10, help="bits on the line per byte, including framing")
+    parser.add_argument("--repeat", type=int, default=1, help="number of times to replay the capture, 0 for forever")
+    parser.add_argument("--chunk-size", type=int, default=64, help="largest number of bytes written at once")
+    parser.add_argument("--wait", type=float, default=5.0, help="seconds to wait for the device to open the port")
+    args = parser.parse_args()
+
+    data = load_capture(args.capture, args.hex)
+    if not data:
+        print("Capture is empty", file=sys.stderr)
+        return 1
+
+    master, slave = os.openpty()
+    tty.setraw(master)
+    tty.setraw(slave)
+    print(f"Replaying {len(data)} bytes on {os.ttyname(slave)}", flush=True)
+    time.sleep(args.wait)
+
+    iteration = 0
+    total_sent = total_received = 0
+    total_time = 0.0
+    try:
+        while args.repeat == 0 or iteration < args.repeat:
+            sent, received, elapsed = replay(master, slave, data, args.baud, args.bits_per_byte, args.chunk_size)
+            total_sent += sent
+            total_received += received
+            total_time += elapsed
+            iteration += 1
+            print(f"Pass {iteration}: {sent} bytes in {elapsed:.3f}s ({sent / elapsed:.0f} B/s)", flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        wait_until_read(slave, args.wait)
+        os.close(master)
+        os.close(slave)
+    if total_time > 0:
+        print(
+            f"Sent {total_sent} bytes in {total_time:.3f}s ({total_sent / total_time:.0f} B/s), "
+            f"received {total_received} bytes"
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
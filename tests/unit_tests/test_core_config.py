@@ -0,0 +1,62 @@
+import pytest
+
+from esphome.core.config import _find_perfect_hash
+from esphome.helpers import fnv1_hash, sanitize, snake_case
+
+ROOMS = ("Living Room", "Kitchen", "Bedroom", "Bathroom", "Office", "Garage")
+MEASUREMENTS = (
+    "Temperature",
+    "Humidity",
+    "Pressure",
+    "Illuminance",
+    "CO2",
+    "Battery Level",
+    "WiFi Signal",
+    "Uptime",
+)
+
+
+def _object_id_hashes(names):
+    return [fnv1_hash(sanitize(snake_case(name))) for name in names]
+
+
+def _lookup(hash_, multiplier, bits, slots):
+    # Same as Application::find_entity_by_key_(), with uint32_t arithmetic
+    return slots[((hash_ * multiplier) & 0xFFFFFFFF) >> (32 - bits)]
+
+
+@pytest.mark.parametrize(
+    "names",
+    (
+        ["Status"],
+        ["Relay 1", "Relay 2"],
+        [f"{room} {measurement}" for room in ROOMS for measurement in MEASUREMENTS],
+        [f"Channel {i}" for i in range(300)],
+    ),
+)
+def test_find_perfect_hash__no_collisions(names):
+    hashes = _object_id_hashes(names)
+    assert len(set(hashes)) == len(hashes)
+
+    result = _find_perfect_hash(hashes)
+
+    assert result is not None
+    multiplier, bits, slots = result
+    assert len(slots) == 1 << bits
+    assert len(slots) <= 8 * max(len(hashes), 1)
+    assert multiplier <= 0xFFFFFFFF
+    # Every key finds its own entity, and no two keys share a slot
+    for index, hash_ in enumerate(hashes):
+        assert _lookup(hash_, multiplier, bits, slots) == index + 1
+    assert sorted(slot for slot in slots if slot) == list(range(1, len(hashes) + 1))
+
+
+def test_find_perfect_hash__unknown_key_misses():
+    hashes = _object_id_hashes(f"{room} Light" for room in ROOMS)
+    multiplier, bits, slots = _find_perfect_hash(hashes)
+
+    unknown = fnv1_hash("attic_light")
+    slot = _lookup(unknown, multiplier, bits, slots)
+
+    # An unknown key lands on an empty slot or on an entity whose hash the C++ side rejects
+    assert slot == 0 or hashes[slot - 1] != unknown
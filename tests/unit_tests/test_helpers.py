@@ -268,3 +268,22 @@ def test_sanitize(text, expected):
     actual = helpers.sanitize(text)
 
     assert actual == expected
+
+
+@pytest.mark.parametrize(
+    "text, expected",
+    (
+        # Computed with fnv1_hash() of esphome/core/helpers.cpp
+        ("", 0x811C9DC5),
+        ("a", 0x050C5D7E),
+        ("foo", 0x408F5E13),
+        ("esphome", 0x28E9366A),
+        ("kitchen_light", 0x8AA0B7C2),
+        ("living_room_temperature", 0x5E1AD2FB),
+        ("Bad Name 1", 0x5B2C2C2E),
+    ),
+)
+def test_fnv1_hash(text, expected):
+    actual = helpers.fnv1_hash(text)
+
+    assert actual == expected